@@ -0,0 +1,85 @@
+# SPDX-License-Identifier: LGPL-3.0-or-later
+# Copyright (C) 2026 agent
+
+# Member table of the generated PODs for the layout auditor
+#
+# The generated components and *Data structs keep the members in the order of
+# the yaml file, followed by an unsigned int pair <name>_begin/<name>_end for
+# every OneToManyRelation and VectorMember. The table written here lists the
+# members of every type, with EDM4EIC_LAYOUT_RANGE for the generated pairs;
+# the layout itself (offsets, sizes and alignments) is taken by the compiler
+# from the generated headers, see utils/src/layout_audit.cpp.
+
+# edm4eic_generate_layout_table(<yaml> <output>)
+function(edm4eic_generate_layout_table yaml output)
+  file(READ ${yaml} contents)
+  # keep one list element per line: drop the characters with a meaning in lists
+  string(REPLACE ";" "," contents "${contents}")
+  string(REPLACE "[" "(" contents "${contents}")
+  string(REPLACE "]" ")" contents "${contents}")
+  string(REPLACE "\n" ";" lines "${contents}")
+
+  set(includes "")
+  set(entries "")
+  set(section "")
+  set(type "")
+  foreach(line IN LISTS lines)
+    string(REGEX REPLACE " *//.*$" "" line "${line}")
+    if(line MATCHES "^([A-Za-z_]+) *:")
+      set(section ${CMAKE_MATCH_1})
+      if(type)
+        _edm4eic_layout_entry()
+      endif()
+      set(type "")
+    elseif(section MATCHES "^(components|datatypes)$" AND line MATCHES "^  edm4eic::([A-Za-z0-9_]+) *:")
+      if(type)
+        _edm4eic_layout_entry()
+      endif()
+      set(name ${CMAKE_MATCH_1})
+      if(section STREQUAL "datatypes")
+        set(type "edm4eic::${name}Data")
+        string(APPEND includes "#include <edm4eic/${name}Data.h>\n")
+      else()
+        set(type "edm4eic::${name}")
+        string(APPEND includes "#include <edm4eic/${name}.h>\n")
+      endif()
+      set(members "")
+      set(ranges "")
+      set(subsection "")
+    elseif(type AND line MATCHES "^    ([A-Za-z]+) *:")
+      set(subsection ${CMAKE_MATCH_1})
+    elseif(type AND line MATCHES "^ +- +([^ ].*[^ ]) +([A-Za-z_][A-Za-z0-9_]*) *$")
+      set(member_type "${CMAKE_MATCH_1}")
+      set(member_name "${CMAKE_MATCH_2}")
+      if(subsection STREQUAL "Members")
+        list(APPEND members "  EDM4EIC_LAYOUT_MEMBER(${type}, ${member_name}, \"${member_type}\")")
+      elseif(subsection MATCHES "^(OneToManyRelations|VectorMembers)$")
+        list(APPEND ranges
+          "  EDM4EIC_LAYOUT_RANGE(${type}, ${member_name}_begin)"
+          "  EDM4EIC_LAYOUT_RANGE(${type}, ${member_name}_end)")
+      endif()
+    endif()
+  endforeach()
+  if(type)
+    _edm4eic_layout_entry()
+  endif()
+
+  set(table "// Generated from ${yaml} by edm4eic_generate_layout_table(), do not edit\n\n")
+  string(APPEND table "${includes}\n")
+  string(APPEND table "const std::vector<type_layout> schema_layouts{\n${entries}};\n")
+  # only touch the table if it changed, to not rebuild the auditor
+  file(WRITE ${output}.tmp "${table}")
+  configure_file(${output}.tmp ${output} COPYONLY)
+  set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${yaml})
+endfunction()
+
+# Append the entry of the current type to the table
+macro(_edm4eic_layout_entry)
+  list(APPEND members ${ranges})
+  if(members)
+    list(JOIN members ",\n" member_lines)
+    string(APPEND entries "EDM4EIC_LAYOUT_TYPE(${type},\n${member_lines}),\n")
+  else()
+    string(APPEND entries "EDM4EIC_LAYOUT_TYPE(${type}),\n")
+  endif()
+endmacro()
@@ -0,0 +1,111 @@
+# SPDX-License-Identifier: LGPL-3.0-or-later
+# Copyright (C) 2026 agent
+
+# Per-subsystem ROOT I/O dictionaries
+#
+# Each subsystem dictionary holds a subset of the edm4eic types, with its own
+# rootmap, so that ROOT autoloads only the dictionaries of the collections a
+# file actually contains. The selection of a subsystem is taken from the
+# generated src/selection.xml, one line at a time. A line that names edm4eic
+# types belongs to the first of them, e.g. std::vector<edm4eic::TrackData>
+# to Track, except for the links between two types, which all belong to the
+# LINKS dictionary:
+#  - lines that belong to types of the subsystem are kept,
+#  - lines that belong to other edm4eic types are dropped,
+#  - other class lines are kept in the COMMON dictionary only,
+#  - lines without a class (the enclosing elements) are kept everywhere.
+# Every line has to belong to exactly one subsystem, which is checked by
+# edm4eic_check_subsystem_dicts().
+
+set(EDM4EIC_TYPE_SUFFIXES "(Data|Obj|Collection|CollectionData)?")
+
+# Type that a line of the selection belongs to, LINKS for links, empty without edm4eic types
+function(_edm4eic_selection_owner line out)
+  if(line MATCHES "podio::Link[A-Za-z]*(<|&lt;) *edm4eic::")
+    set(${out} LINKS PARENT_SCOPE)
+  elseif(line MATCHES "edm4eic::(Mutable)?([A-Za-z0-9_]+)")
+    set(${out} ${CMAKE_MATCH_2} PARENT_SCOPE)
+  else()
+    set(${out} "" PARENT_SCOPE)
+  endif()
+endfunction()
+
+# edm4eic_add_subsystem_dict(<name> HEADERS <headers> TYPES <type>... [DEPENDS <dict>...] [COMMON] [LINKS])
+function(edm4eic_add_subsystem_dict name)
+  cmake_parse_arguments(ARG "COMMON;LINKS" "" "HEADERS;TYPES;DEPENDS" ${ARGN})
+
+  string(REPLACE ";" "|" types_regex "${ARG_TYPES}")
+  set(owner_regex "^(${types_regex})${EDM4EIC_TYPE_SUFFIXES}$")
+  set(header_regex "^(Mutable)?(${types_regex})${EDM4EIC_TYPE_SUFFIXES}\\.h$")
+
+  file(STRINGS ${CMAKE_CURRENT_BINARY_DIR}/src/selection.xml selection_lines)
+  set(selection "")
+  foreach(line IN LISTS selection_lines)
+    if(line MATCHES "edm4eic::")
+      _edm4eic_selection_owner("${line}" owner)
+      if(owner STREQUAL "LINKS")
+        set(keep ${ARG_LINKS})
+      elseif(owner MATCHES "${owner_regex}")
+        set(keep TRUE)
+      else()
+        set(keep FALSE)
+      endif()
+    elseif(line MATCHES "name=")
+      set(keep ${ARG_COMMON})
+    else()
+      set(keep TRUE)
+    endif()
+    if(keep)
+      string(APPEND selection "${line}\n")
+    endif()
+  endforeach()
+  # only touch the selection if it changed, to not regenerate the dictionary
+  file(WRITE ${CMAKE_CURRENT_BINARY_DIR}/src/selection_${name}.xml.tmp "${selection}")
+  configure_file(${CMAKE_CURRENT_BINARY_DIR}/src/selection_${name}.xml.tmp
+    ${CMAKE_CURRENT_BINARY_DIR}/src/selection_${name}.xml COPYONLY)
+
+  set(dict_headers "")
+  foreach(header IN LISTS ARG_HEADERS)
+    get_filename_component(header_name ${header} NAME)
+    if(header_name MATCHES "${header_regex}")
+      list(APPEND dict_headers ${header})
+    endif()
+  endforeach()
+
+  PODIO_ADD_ROOT_IO_DICT(${name} edm4eic "${dict_headers}" src/selection_${name}.xml
+    OUTPUT_FOLDER ${CMAKE_CURRENT_BINARY_DIR}
+  )
+  add_library(edm4eic::${name} ALIAS ${name})
+  if(ARG_DEPENDS)
+    target_link_libraries(${name} PUBLIC ${ARG_DEPENDS})
+  endif()
+
+  set_property(GLOBAL APPEND PROPERTY EDM4EIC_SUBSYSTEM_DICTS ${name})
+  set_property(GLOBAL APPEND PROPERTY EDM4EIC_SUBSYSTEM_DICT_TYPES ${ARG_TYPES})
+  if(ARG_LINKS)
+    set_property(GLOBAL APPEND PROPERTY EDM4EIC_SUBSYSTEM_DICT_TYPES LINKS)
+  endif()
+endfunction()
+
+# Fail if a line of the generated selection belongs to no or several subsystem dictionaries
+function(edm4eic_check_subsystem_dicts)
+  get_property(types GLOBAL PROPERTY EDM4EIC_SUBSYSTEM_DICT_TYPES)
+  set(seen "")
+  foreach(type IN LISTS types)
+    if(type IN_LIST seen)
+      message(FATAL_ERROR "${type} is in several subsystem dictionaries")
+    endif()
+    list(APPEND seen ${type})
+  endforeach()
+  string(REPLACE ";" "|" types_regex "${types}")
+  set(owner_regex "^(${types_regex})${EDM4EIC_TYPE_SUFFIXES}$")
+
+  file(STRINGS ${CMAKE_CURRENT_BINARY_DIR}/src/selection.xml selection_lines REGEX "edm4eic::")
+  foreach(line IN LISTS selection_lines)
+    _edm4eic_selection_owner("${line}" owner)
+    if(NOT owner MATCHES "${owner_regex}")
+      message(FATAL_ERROR "No subsystem dictionary for the edm4eic type in\n  ${line}\n"
+        "Add the type to one of the subsystems in CMakeLists.txt.")
+    endif()
+  endforeach()
+endfunction()
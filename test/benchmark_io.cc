@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmark_io.h"
+
+#include <podio/ROOTReader.h>
+#include <podio/ROOTWriter.h>
+#if __has_include(<podio/RNTupleWriter.h>)
+#include <podio/RNTupleReader.h>
+#include <podio/RNTupleWriter.h>
+#define EDM4EIC_BENCHMARK_RNTUPLE
+#endif
+
+#include <iostream>
+
+// Usage: benchmark_io [--events N] [--hits N] [--fanout N] [--samples N] [--directory DIR] [--datatype NAME]
+int main(int argc, char* argv[]) {
+  bench_config config;
+  std::string only;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string option = argv[i];
+    const std::string value = argv[i + 1];
+    if (option == "--events") {
+      config.events = std::stoul(value);
+    } else if (option == "--hits") {
+      config.hits = std::stoul(value);
+    } else if (option == "--fanout") {
+      config.fanout = std::stoul(value);
+    } else if (option == "--samples") {
+      config.samples = std::stoul(value);
+    } else if (option == "--directory") {
+      config.directory = value;
+    } else if (option == "--datatype") {
+      only = value;
+    } else {
+      std::cerr << "unknown option " << option << std::endl;
+      return 1;
+    }
+  }
+
+  for (const auto& benchmark : bench_cases()) {
+    if (!only.empty() && benchmark.datatype != only) {
+      continue;
+    }
+    const std::string stem = config.directory + "/edm4eic_benchmark";
+    print_result("ROOT", benchmark, config,
+                 run_case_isolated<podio::ROOTWriter, podio::ROOTReader>(benchmark, config, stem + ".root"));
+#ifdef EDM4EIC_BENCHMARK_RNTUPLE
+    print_result("RNTuple", benchmark, config,
+                 run_case_isolated<podio::RNTupleWriter, podio::RNTupleReader>(benchmark, config, stem + "_rntuple.root"));
+#endif
+  }
+
+  return 0;
+}
@@ -0,0 +1,968 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef EDM4EIC_TEST_BENCHMARK_IO_H
+#define EDM4EIC_TEST_BENCHMARK_IO_H
+
+// Data model
+#include "edm4eic/CalorimeterHitCollection.h"
+#include "edm4eic/CherenkovParticleIDCollection.h"
+#include "edm4eic/ClusterCollection.h"
+#include "edm4eic/HadronicFinalStateCollection.h"
+#include "edm4eic/InclusiveKinematicsCollection.h"
+#include "edm4eic/IrtParticleCollection.h"
+#include "edm4eic/IrtRadiatorInfoCollection.h"
+#include "edm4eic/JetCollection.h"
+#include "edm4eic/MCRecoCalorimeterHitAssociationCollection.h"
+#include "edm4eic/MCRecoCalorimeterHitLinkCollection.h"
+#include "edm4eic/MCRecoClusterParticleAssociationCollection.h"
+#include "edm4eic/MCRecoClusterParticleLinkCollection.h"
+#include "edm4eic/MCRecoParticleAssociationCollection.h"
+#include "edm4eic/MCRecoParticleLinkCollection.h"
+#include "edm4eic/MCRecoTrackParticleAssociationCollection.h"
+#include "edm4eic/MCRecoTrackParticleLinkCollection.h"
+#include "edm4eic/MCRecoTrackerHitAssociationCollection.h"
+#include "edm4eic/MCRecoTrackerHitLinkCollection.h"
+#include "edm4eic/MCRecoVertexParticleAssociationCollection.h"
+#include "edm4eic/MCRecoVertexParticleLinkCollection.h"
+#include "edm4eic/Measurement2DCollection.h"
+#include "edm4eic/PMTHitCollection.h"
+#include "edm4eic/ProtoClusterCollection.h"
+#include "edm4eic/RawCALOROCHitCollection.h"
+#include "edm4eic/RawTrackerHitCollection.h"
+#include "edm4eic/ReconstructedParticleCollection.h"
+#include "edm4eic/RingImageCollection.h"
+#include "edm4eic/SimPulseCollection.h"
+#include "edm4eic/TensorCollection.h"
+#include "edm4eic/TrackClusterLinkCollection.h"
+#include "edm4eic/TrackClusterMatchCollection.h"
+#include "edm4eic/TrackCollection.h"
+#include "edm4eic/TrackParametersCollection.h"
+#include "edm4eic/TrackProtoClusterLinkCollection.h"
+#include "edm4eic/TrackProtoClusterMatchCollection.h"
+#include "edm4eic/TrackSeedCollection.h"
+#include "edm4eic/TrackSegmentCollection.h"
+#include "edm4eic/TrackerHitCollection.h"
+#include "edm4eic/TrajectoryCollection.h"
+#include "edm4eic/TruthinessCollection.h"
+#include "edm4eic/VertexCollection.h"
+#include "edm4hep/MCParticleCollection.h"
+#include "edm4hep/RawCalorimeterHitCollection.h"
+#include "edm4hep/SimCalorimeterHitCollection.h"
+#include "edm4hep/SimTrackerHitCollection.h"
+
+// podio specific includes
+#include "podio/Frame.h"
+
+// STL
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Shape of the synthetic events
+struct bench_config {
+  unsigned events = 100;
+  unsigned hits = 1000;   // objects per collection and event
+  unsigned fanout = 8;    // OneToMany relations per object
+  unsigned samples = 16;  // VectorMember entries per object
+  std::string directory = ".";
+};
+
+// One benchmarked datatype: fill() puts the collection "bench", plus any
+// collections its relations point into, into the frame
+struct bench_case {
+  std::string datatype;
+  std::function<void(podio::Frame&, const bench_config&, std::mt19937&)> fill;
+};
+
+// Trivially copyable, it is passed from the process that ran the case
+struct bench_result {
+  double write_seconds = 0;
+  double read_seconds = 0;
+  std::uintmax_t file_bytes = 0;
+  std::size_t objects = 0;
+  long start_rss_kb = 0; // resident set when the case started
+  long peak_rss_kb = 0;  // peak resident set of the process that ran the case
+};
+
+// Current resident set of this process
+inline long current_rss_kb() {
+  long pages = 0;
+  long resident = 0;
+  std::ifstream statm("/proc/self/statm");
+  if (!(statm >> pages >> resident)) {
+    return 0;
+  }
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+namespace bench {
+
+inline float uniform(std::mt19937& rng, float lo, float hi) {
+  return std::uniform_real_distribution<float>{lo, hi}(rng);
+}
+inline edm4hep::Vector3f position(std::mt19937& rng) {
+  return {uniform(rng, -1000, 1000), uniform(rng, -1000, 1000), uniform(rng, -3000, 3000)};
+}
+inline edm4hep::Vector3f momentum(std::mt19937& rng) {
+  return {uniform(rng, -5, 5), uniform(rng, -5, 5), uniform(rng, -20, 20)};
+}
+inline uint64_t cellID(std::mt19937& rng) { return std::uniform_int_distribution<uint64_t>{}(rng); }
+inline int32_t adc(std::mt19937& rng) { return std::uniform_int_distribution<int32_t>{0, 4095}(rng); }
+
+// `fanout` distinct-ish targets out of `size`, e.g. the hits of a cluster
+inline std::vector<std::size_t> targets(const bench_config& config, std::size_t size, std::mt19937& rng) {
+  std::vector<std::size_t> indices(size > 0 ? config.fanout : 0);
+  for (auto& index : indices) {
+    index = std::uniform_int_distribution<std::size_t>{0, size - 1}(rng);
+  }
+  return indices;
+}
+
+// The collections that relations point into. Cases put them into the frame
+// first and relate to the objects of the returned frame-owned collections
+
+inline edm4hep::MCParticleCollection mc_particles(const bench_config& config, std::mt19937& rng) {
+  edm4hep::MCParticleCollection particles;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto particle = particles.create();
+    particle.setPDG(i % 2 ? 211 : -211);
+    particle.setGeneratorStatus(1);
+    particle.setCharge(i % 2 ? 1 : -1);
+    particle.setMass(0.13957);
+    particle.setTime(uniform(rng, 0, 1));
+    particle.setVertex({uniform(rng, -1, 1), uniform(rng, -1, 1), uniform(rng, -100, 100)});
+    particle.setMomentum({uniform(rng, -5, 5), uniform(rng, -5, 5), uniform(rng, -20, 20)});
+  }
+  return particles;
+}
+
+inline edm4hep::SimTrackerHitCollection sim_tracker_hits(const bench_config& config, std::mt19937& rng) {
+  edm4hep::SimTrackerHitCollection hits;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto hit = hits.create();
+    hit.setCellID(cellID(rng));
+    hit.setEDep(uniform(rng, 0, 1e-4));
+    hit.setTime(uniform(rng, 0, 100));
+    hit.setPosition({uniform(rng, -1000, 1000), uniform(rng, -1000, 1000), uniform(rng, -3000, 3000)});
+    hit.setMomentum(momentum(rng));
+  }
+  return hits;
+}
+
+inline edm4hep::RawCalorimeterHitCollection raw_calorimeter_hits(const bench_config& config, std::mt19937& rng) {
+  edm4hep::RawCalorimeterHitCollection hits;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto hit = hits.create();
+    hit.setCellID(cellID(rng));
+    hit.setAmplitude(adc(rng));
+    hit.setTimeStamp(std::uniform_int_distribution<int32_t>{0, 1023}(rng));
+  }
+  return hits;
+}
+
+inline edm4hep::SimCalorimeterHitCollection sim_calorimeter_hits(const bench_config& config, std::mt19937& rng) {
+  edm4hep::SimCalorimeterHitCollection hits;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto hit = hits.create();
+    hit.setCellID(cellID(rng));
+    hit.setEnergy(uniform(rng, 0, 1));
+    hit.setPosition(position(rng));
+  }
+  return hits;
+}
+
+inline edm4eic::CalorimeterHitCollection calorimeter_hits(const bench_config& config, std::mt19937& rng) {
+  edm4eic::CalorimeterHitCollection hits;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto hit = hits.create();
+    hit.setCellID(cellID(rng));
+    hit.setEnergy(uniform(rng, 0, 1));
+    hit.setEnergyError(uniform(rng, 0, 0.1));
+    hit.setTime(uniform(rng, 0, 100));
+    hit.setTimeError(uniform(rng, 0, 1));
+    hit.setPosition(position(rng));
+    hit.setDimension({10, 10, 20});
+    hit.setSector(static_cast<int32_t>(i % 8));
+    hit.setLayer(static_cast<int32_t>(i % 40));
+    hit.setLocal(position(rng));
+  }
+  return hits;
+}
+
+inline edm4eic::TrackerHitCollection tracker_hits(const bench_config& config, std::mt19937& rng) {
+  edm4eic::TrackerHitCollection hits;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto hit = hits.create();
+    hit.setCellID(cellID(rng));
+    hit.setPosition(position(rng));
+    hit.setPositionError({0.01, 0.01, 0.01});
+    hit.setTime(uniform(rng, 0, 100));
+    hit.setTimeError(uniform(rng, 0, 1));
+    hit.setEdep(uniform(rng, 0, 1e-4));
+    hit.setEdepError(uniform(rng, 0, 1e-5));
+  }
+  return hits;
+}
+
+inline edm4eic::RawTrackerHitCollection raw_tracker_hits(const bench_config& config, std::mt19937& rng) {
+  edm4eic::RawTrackerHitCollection hits;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto hit = hits.create();
+    hit.setCellID(cellID(rng));
+    hit.setCharge(adc(rng));
+    hit.setTimeStamp(std::uniform_int_distribution<int32_t>{0, 1023}(rng));
+  }
+  return hits;
+}
+
+inline edm4eic::ProtoClusterCollection protoclusters(const bench_config& config, std::mt19937& rng,
+                                                     const edm4eic::CalorimeterHitCollection& hits) {
+  edm4eic::ProtoClusterCollection protoclusters;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto protocluster = protoclusters.create();
+    for (auto index : targets(config, hits.size(), rng)) {
+      protocluster.addToHits(hits[index]);
+      protocluster.addToWeights(uniform(rng, 0, 1));
+    }
+  }
+  return protoclusters;
+}
+
+inline edm4eic::ClusterCollection clusters(const bench_config& config, std::mt19937& rng,
+                                           const edm4eic::CalorimeterHitCollection& hits) {
+  edm4eic::ClusterCollection clusters;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto cluster = clusters.create();
+    cluster.setEnergy(uniform(rng, 0, 10));
+    cluster.setTime(uniform(rng, 0, 100));
+    cluster.setNhits(config.fanout);
+    cluster.setPosition(position(rng));
+    for (auto index : targets(config, hits.size(), rng)) {
+      cluster.addToHits(hits[index]);
+      cluster.addToHitContributions(uniform(rng, 0, 1));
+    }
+    for (unsigned s = 0; s < config.samples; ++s) {
+      cluster.addToShapeParameters(uniform(rng, 0, 100));
+    }
+  }
+  return clusters;
+}
+
+inline edm4eic::Measurement2DCollection measurements(const bench_config& config, std::mt19937& rng,
+                                                     const edm4eic::TrackerHitCollection& hits) {
+  edm4eic::Measurement2DCollection measurements;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto measurement = measurements.create();
+    measurement.setSurface(cellID(rng));
+    measurement.setLoc({uniform(rng, -10, 10), uniform(rng, -10, 10)});
+    measurement.setCovariance({0.01, 0.01, 1});
+    for (auto index : targets(config, hits.size(), rng)) {
+      measurement.addToHits(hits[index]);
+      measurement.addToWeights(1.f / config.fanout);
+    }
+  }
+  return measurements;
+}
+
+inline edm4eic::Cov6f covariance(std::mt19937& rng) {
+  edm4eic::Cov6f covariance;
+  for (auto& element : covariance.covariance) {
+    element = uniform(rng, 0, 1e-3);
+  }
+  return covariance;
+}
+
+inline edm4eic::TrackParametersCollection track_parameters(const bench_config& config, std::mt19937& rng) {
+  edm4eic::TrackParametersCollection parameters;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto params = parameters.create();
+    params.setSurface(cellID(rng));
+    params.setLoc({uniform(rng, -10, 10), uniform(rng, -10, 10)});
+    params.setTheta(uniform(rng, 0, 3.14));
+    params.setPhi(uniform(rng, -3.14, 3.14));
+    params.setQOverP(uniform(rng, -1, 1));
+    params.setCovariance(covariance(rng));
+  }
+  return parameters;
+}
+
+inline edm4eic::TrackCollection tracks(const bench_config& config, std::mt19937& rng) {
+  edm4eic::TrackCollection tracks;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto track = tracks.create();
+    track.setType(0);
+    track.setPosition({uniform(rng, -1, 1), uniform(rng, -1, 1), uniform(rng, -100, 100)});
+    track.setMomentum(momentum(rng));
+    track.setPositionMomentumCovariance(covariance(rng));
+    track.setTime(uniform(rng, 0, 100));
+    track.setTimeError(uniform(rng, 0, 1));
+    track.setCharge(i % 2 ? 1 : -1);
+    track.setChi2(uniform(rng, 0, 20));
+    track.setNdf(config.fanout);
+    track.setPdg(211);
+  }
+  return tracks;
+}
+
+inline edm4eic::ReconstructedParticleCollection reconstructed_particles(const bench_config& config,
+                                                                        std::mt19937& rng) {
+  edm4eic::ReconstructedParticleCollection particles;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto particle = particles.create();
+    particle.setEnergy(uniform(rng, 0, 100));
+    particle.setMomentum(momentum(rng));
+    particle.setReferencePoint({uniform(rng, -1, 1), uniform(rng, -1, 1), uniform(rng, -100, 100)});
+    particle.setCharge(i % 2 ? 1 : -1);
+    particle.setMass(0.13957);
+    particle.setPDG(211);
+  }
+  return particles;
+}
+
+inline edm4eic::VertexCollection vertices(const bench_config& config, std::mt19937& rng,
+                                          const edm4eic::ReconstructedParticleCollection& particles) {
+  edm4eic::VertexCollection vertices;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto vertex = vertices.create();
+    vertex.setType(i == 0 ? 1 : 2);
+    vertex.setChi2(uniform(rng, 0, 20));
+    vertex.setNdf(static_cast<int>(config.fanout));
+    vertex.setPosition({uniform(rng, -1, 1), uniform(rng, -1, 1), uniform(rng, -100, 100), uniform(rng, 0, 1)});
+    vertex.setPositionError({0.01, 0.01, 1, 0.1});
+    for (auto index : targets(config, particles.size(), rng)) {
+      vertex.addToAssociatedParticles(particles[index]);
+    }
+  }
+  return vertices;
+}
+
+inline edm4eic::MCRecoTrackerHitAssociationCollection
+tracker_hit_associations(const bench_config& config, std::mt19937& rng, const edm4eic::RawTrackerHitCollection& raw_hits,
+                         const edm4hep::SimTrackerHitCollection& sim_hits) {
+  edm4eic::MCRecoTrackerHitAssociationCollection associations;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto association = associations.create();
+    association.setWeight(uniform(rng, 0, 1));
+    association.setRawHit(raw_hits[i]);
+    association.setSimHit(sim_hits[i]);
+  }
+  return associations;
+}
+
+inline edm4eic::MCRecoParticleAssociationCollection
+particle_associations(const bench_config& config, std::mt19937& rng,
+                      const edm4eic::ReconstructedParticleCollection& particles,
+                      const edm4hep::MCParticleCollection& mc_particles) {
+  edm4eic::MCRecoParticleAssociationCollection associations;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto association = associations.create();
+    association.setWeight(uniform(rng, 0, 1));
+    association.setRec(particles[i]);
+    association.setSim(mc_particles[i]);
+  }
+  return associations;
+}
+
+// One object of `from` per link, to a random object of `to`
+template <typename LinkCollT, typename FromCollT, typename ToCollT>
+LinkCollT links(const bench_config& config, std::mt19937& rng, const FromCollT& from, const ToCollT& to) {
+  LinkCollT links;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto link = links.create();
+    link.setWeight(uniform(rng, 0, 1));
+    link.setFrom(from[i]);
+    link.setTo(to[targets(config, to.size(), rng).at(0)]);
+  }
+  return links;
+}
+
+// Same for an association with rec and sim ends
+template <typename AssocCollT, typename RecCollT, typename SimCollT>
+AssocCollT rec_sim_associations(const bench_config& config, std::mt19937& rng, const RecCollT& rec,
+                                const SimCollT& sim) {
+  AssocCollT associations;
+  for (unsigned i = 0; i < config.hits; ++i) {
+    auto association = associations.create();
+    association.setWeight(uniform(rng, 0, 1));
+    association.setRec(rec[i]);
+    association.setSim(sim[targets(config, sim.size(), rng).at(0)]);
+  }
+  return associations;
+}
+
+} // namespace bench
+
+inline std::vector<bench_case> bench_cases() {
+  using namespace bench;
+  std::vector<bench_case> cases;
+
+  cases.push_back({"edm4eic::RawTrackerHit", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     frame.put(raw_tracker_hits(config, rng), "bench");
+                   }});
+  cases.push_back({"edm4eic::TrackerHit", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     frame.put(tracker_hits(config, rng), "bench");
+                   }});
+  cases.push_back({"edm4eic::CalorimeterHit", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     frame.put(calorimeter_hits(config, rng), "bench");
+                   }});
+  cases.push_back({"edm4eic::PMTHit", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     edm4eic::PMTHitCollection hits;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto hit = hits.create();
+                       hit.setCellID(cellID(rng));
+                       hit.setNpe(uniform(rng, 0, 10));
+                       hit.setTime(uniform(rng, 0, 100));
+                       hit.setPosition(position(rng));
+                     }
+                     frame.put(std::move(hits), "bench");
+                   }});
+  cases.push_back({"edm4eic::RawCALOROCHit", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     edm4eic::RawCALOROCHitCollection hits;
+                     std::uniform_int_distribution<uint16_t> adc{0, 1023};
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto hit = hits.create();
+                       hit.setCellID(cellID(rng));
+                       hit.setTimeStamp(std::uniform_int_distribution<int32_t>{0, 1023}(rng));
+                       for (unsigned s = 0; s < config.samples; ++s) {
+                         hit.addToASamples({adc(rng), adc(rng), adc(rng)});
+                         hit.addToBSamples({adc(rng), adc(rng), adc(rng)});
+                       }
+                     }
+                     frame.put(std::move(hits), "bench");
+                   }});
+  cases.push_back({"edm4eic::SimPulse", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     edm4eic::SimPulseCollection pulses;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto pulse = pulses.create();
+                       pulse.setCellID(cellID(rng));
+                       pulse.setTime(uniform(rng, 0, 100));
+                       pulse.setInterval(0.1);
+                       pulse.setPosition(position(rng));
+                       for (unsigned s = 0; s < config.samples; ++s) {
+                         pulse.addToAmplitude(uniform(rng, 0, 1));
+                       }
+                       // combined pulses point to earlier ones
+                       for (auto index : targets(config, i, rng)) {
+                         pulse.addToPulses(pulses[index]);
+                       }
+                     }
+                     frame.put(std::move(pulses), "bench");
+                   }});
+  cases.push_back({"edm4eic::ProtoCluster", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& hits = frame.put(calorimeter_hits(config, rng), "bench_hits");
+                     frame.put(protoclusters(config, rng, hits), "bench");
+                   }});
+  cases.push_back({"edm4eic::Cluster", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& hits = frame.put(calorimeter_hits(config, rng), "bench_hits");
+                     frame.put(clusters(config, rng, hits), "bench");
+                   }});
+  cases.push_back({"edm4eic::Measurement2D", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& hits = frame.put(tracker_hits(config, rng), "bench_hits");
+                     frame.put(measurements(config, rng, hits), "bench");
+                   }});
+  cases.push_back({"edm4eic::TrackParameters", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     frame.put(track_parameters(config, rng), "bench");
+                   }});
+  cases.push_back({"edm4eic::ReconstructedParticle", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     auto particles = reconstructed_particles(config, rng);
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       // decay products point to earlier particles
+                       for (auto index : targets(config, i, rng)) {
+                         particles[i].addToParticles(particles[index]);
+                       }
+                     }
+                     frame.put(std::move(particles), "bench");
+                   }});
+  cases.push_back({"edm4eic::MCRecoTrackerHitAssociation", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& raw_hits = frame.put(raw_tracker_hits(config, rng), "bench_raw_hits");
+                     const auto& sim_hits = frame.put(sim_tracker_hits(config, rng), "bench_sim_hits");
+                     frame.put(tracker_hit_associations(config, rng, raw_hits, sim_hits), "bench");
+                   }});
+
+  cases.push_back({"edm4eic::Tensor", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     edm4eic::TensorCollection tensors;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto tensor = tensors.create();
+                       // alternate float and int64 tensors of shape (samples, 4)
+                       const bool floats = i % 2 == 0;
+                       tensor.setElementType(floats ? 1 : 7);
+                       tensor.addToShape(config.samples);
+                       tensor.addToShape(4);
+                       for (unsigned s = 0; s < 4 * config.samples; ++s) {
+                         if (floats) {
+                           tensor.addToFloatData(uniform(rng, -1, 1));
+                         } else {
+                           tensor.addToInt64Data(adc(rng));
+                         }
+                       }
+                     }
+                     frame.put(std::move(tensors), "bench");
+                   }});
+  cases.push_back({"edm4eic::CherenkovParticleID", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& raw_hits = frame.put(raw_tracker_hits(config, rng), "bench_raw_hits");
+                     const auto& sim_hits = frame.put(sim_tracker_hits(config, rng), "bench_sim_hits");
+                     const auto& hit_associations = frame.put(
+                         tracker_hit_associations(config, rng, raw_hits, sim_hits), "bench_hit_associations");
+                     const auto& tracks = frame.put(bench::tracks(config, rng), "bench_tracks");
+                     edm4eic::TrackSegmentCollection segments;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto segment = segments.create();
+                       segment.setTrack(tracks[i]);
+                     }
+                     const auto& charged_particles = frame.put(std::move(segments), "bench_segments");
+                     edm4eic::CherenkovParticleIDCollection pids;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto pid = pids.create();
+                       pid.setNpe(uniform(rng, 0, 30));
+                       pid.setRefractiveIndex(uniform(rng, 1, 1.1));
+                       pid.setPhotonEnergy(uniform(rng, 2e-9, 5e-9));
+                       for (const int32_t pdg : {11, 211, 321, 2212}) {
+                         pid.addToHypotheses({pdg, uniform(rng, 0, 30), uniform(rng, 0, 1)});
+                       }
+                       for (unsigned s = 0; s < config.samples; ++s) {
+                         pid.addToThetaPhiPhotons({uniform(rng, 0, 0.05), uniform(rng, -3.14, 3.14)});
+                       }
+                       pid.setChargedParticle(charged_particles[i]);
+                       for (auto index : targets(config, hit_associations.size(), rng)) {
+                         pid.addToRawHitAssociations(hit_associations[index]);
+                       }
+                     }
+                     frame.put(std::move(pids), "bench");
+                   }});
+  cases.push_back({"edm4eic::IrtRadiatorInfo", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     edm4eic::IrtRadiatorInfoCollection radiators;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto radiator = radiators.create();
+                       radiator.setNpe(static_cast<uint16_t>(i % 30));
+                       radiator.setNhits(static_cast<uint16_t>(i % 40));
+                       radiator.setAngle(uniform(rng, 0, 0.05));
+                     }
+                     frame.put(std::move(radiators), "bench");
+                   }});
+  cases.push_back({"edm4eic::IrtParticle", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& tracks = frame.put(bench::tracks(config, rng), "bench_tracks");
+                     edm4eic::IrtRadiatorInfoCollection radiators;
+                     for (unsigned i = 0; i < 2 * config.hits; ++i) {
+                       auto radiator = radiators.create();
+                       radiator.setNpe(static_cast<uint16_t>(i % 30));
+                       radiator.setNhits(static_cast<uint16_t>(i % 40));
+                       radiator.setAngle(uniform(rng, 0, 0.05));
+                     }
+                     const auto& radiator_infos = frame.put(std::move(radiators), "bench_radiators");
+                     edm4eic::IrtParticleCollection particles;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto particle = particles.create();
+                       particle.setPDG(211);
+                       particle.setNpe(static_cast<uint16_t>(i % 60));
+                       particle.setNhits(static_cast<uint16_t>(i % 80));
+                       particle.setTrack(tracks[i]);
+                       // aerogel and gas
+                       particle.addToRadiators(radiator_infos[2 * i]);
+                       particle.addToRadiators(radiator_infos[2 * i + 1]);
+                     }
+                     frame.put(std::move(particles), "bench");
+                   }});
+  cases.push_back({"edm4eic::RingImage", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     edm4eic::RingImageCollection rings;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto ring = rings.create();
+                       ring.setNpe(uniform(rng, 0, 30));
+                       ring.setPosition(position(rng));
+                       ring.setPositionError({1, 1, 1});
+                       ring.setTheta(uniform(rng, 0, 0.05));
+                       ring.setThetaError(uniform(rng, 0, 1e-3));
+                       ring.setRadius(uniform(rng, 0, 100));
+                       ring.setRadiusError(uniform(rng, 0, 1));
+                     }
+                     frame.put(std::move(rings), "bench");
+                   }});
+  cases.push_back({"edm4eic::TrackSeed", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& hits = frame.put(tracker_hits(config, rng), "bench_hits");
+                     const auto& parameters = frame.put(track_parameters(config, rng), "bench_parameters");
+                     edm4eic::TrackSeedCollection seeds;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto seed = seeds.create();
+                       seed.setPerigee({0, 0, uniform(rng, -100, 100)});
+                       seed.setQuality(uniform(rng, 0, 1));
+                       // triplets
+                       for (unsigned h = 0; h < 3; ++h) {
+                         seed.addToHits(hits[targets(config, hits.size(), rng).at(0)]);
+                       }
+                       seed.setParams(parameters[i]);
+                     }
+                     frame.put(std::move(seeds), "bench");
+                   }});
+  cases.push_back({"edm4eic::Trajectory", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& hits = frame.put(tracker_hits(config, rng), "bench_hits");
+                     const auto& measurements = frame.put(bench::measurements(config, rng, hits), "bench_measurements");
+                     const auto& parameters = frame.put(track_parameters(config, rng), "bench_parameters");
+                     edm4eic::TrajectoryCollection trajectories;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto trajectory = trajectories.create();
+                       trajectory.setType(1);
+                       trajectory.setNStates(config.samples);
+                       trajectory.setNMeasurements(config.fanout);
+                       trajectory.setNOutliers(1);
+                       trajectory.setNHoles(0);
+                       trajectory.setNSharedHits(i % 2);
+                       for (unsigned s = 0; s < config.samples; ++s) {
+                         trajectory.addToMeasurementChi2(uniform(rng, 0, 5));
+                       }
+                       trajectory.addToOutlierChi2(uniform(rng, 10, 100));
+                       trajectory.addToTrackParameters(parameters[i]);
+                       for (auto index : targets(config, measurements.size(), rng)) {
+                         trajectory.addToMeasurements_deprecated(measurements[index]);
+                       }
+                       trajectory.addToOutliers_deprecated(measurements[targets(config, measurements.size(), rng).at(0)]);
+                     }
+                     frame.put(std::move(trajectories), "bench");
+                   }});
+  cases.push_back({"edm4eic::Track", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& hits = frame.put(tracker_hits(config, rng), "bench_hits");
+                     const auto& measurements = frame.put(bench::measurements(config, rng, hits), "bench_measurements");
+                     edm4eic::TrajectoryCollection trajectory_collection;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto trajectory = trajectory_collection.create();
+                       trajectory.setType(1);
+                       trajectory.setNMeasurements(config.fanout);
+                     }
+                     const auto& trajectories = frame.put(std::move(trajectory_collection), "bench_trajectories");
+                     auto tracks = bench::tracks(config, rng);
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto track = tracks[i];
+                       track.setTrajectory(trajectories[i]);
+                       for (auto index : targets(config, measurements.size(), rng)) {
+                         track.addToMeasurements(measurements[index]);
+                       }
+                       // combined tracks point to earlier segments
+                       for (auto index : targets(config, i, rng)) {
+                         track.addToTracks(tracks[index]);
+                       }
+                     }
+                     frame.put(std::move(tracks), "bench");
+                   }});
+  cases.push_back({"edm4eic::TrackSegment", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& tracks = frame.put(bench::tracks(config, rng), "bench_tracks");
+                     edm4eic::TrackSegmentCollection segments;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto segment = segments.create();
+                       segment.setLength(uniform(rng, 0, 1000));
+                       segment.setLengthError(uniform(rng, 0, 1));
+                       segment.setTrack(tracks[i]);
+                       for (unsigned s = 0; s < config.samples; ++s) {
+                         edm4eic::TrackPoint point;
+                         point.surface = cellID(rng);
+                         point.system = s % 4;
+                         point.position = position(rng);
+                         point.positionError = {0.01, 0.01, 0.01};
+                         point.momentum = momentum(rng);
+                         point.momentumError = {1e-3, 1e-3, 1e-3};
+                         point.time = uniform(rng, 0, 100);
+                         point.timeError = uniform(rng, 0, 1);
+                         point.theta = uniform(rng, 0, 3.14);
+                         point.phi = uniform(rng, -3.14, 3.14);
+                         point.directionError = {1e-4, 1e-4};
+                         point.pathlength = uniform(rng, 0, 1000);
+                         point.pathlengthError = uniform(rng, 0, 1);
+                         segment.addToPoints(point);
+                       }
+                     }
+                     frame.put(std::move(segments), "bench");
+                   }});
+  cases.push_back({"edm4eic::Vertex", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& particles = frame.put(reconstructed_particles(config, rng), "bench_particles");
+                     frame.put(vertices(config, rng, particles), "bench");
+                   }});
+  cases.push_back({"edm4eic::InclusiveKinematics", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& particles = frame.put(reconstructed_particles(config, rng), "bench_particles");
+                     edm4eic::InclusiveKinematicsCollection kinematics;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto kinematic = kinematics.create();
+                       kinematic.setX(uniform(rng, 1e-4, 1));
+                       kinematic.setQ2(uniform(rng, 1, 1000));
+                       kinematic.setW(uniform(rng, 2, 140));
+                       kinematic.setY(uniform(rng, 0, 1));
+                       kinematic.setNu(uniform(rng, 0, 1e4));
+                       kinematic.setScat(particles[i]);
+                     }
+                     frame.put(std::move(kinematics), "bench");
+                   }});
+  cases.push_back({"edm4eic::HadronicFinalState", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& particles = frame.put(reconstructed_particles(config, rng), "bench_particles");
+                     edm4eic::HadronicFinalStateCollection states;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto state = states.create();
+                       state.setSigma(uniform(rng, 0, 40));
+                       state.setPT(uniform(rng, 0, 10));
+                       state.setGamma(uniform(rng, 0, 3.14));
+                       for (auto index : targets(config, particles.size(), rng)) {
+                         state.addToHadrons(particles[index]);
+                       }
+                     }
+                     frame.put(std::move(states), "bench");
+                   }});
+  cases.push_back({"edm4eic::Jet", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& particles = frame.put(reconstructed_particles(config, rng), "bench_particles");
+                     edm4eic::JetCollection jets;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto jet = jets.create();
+                       jet.setType(2);
+                       jet.setArea(uniform(rng, 0, 3.14));
+                       jet.setEnergy(uniform(rng, 0, 100));
+                       jet.setBackgroundEnergyDensity(uniform(rng, 0, 1));
+                       jet.setMomentum(momentum(rng));
+                       for (auto index : targets(config, particles.size(), rng)) {
+                         jet.addToConstituents(particles[index]);
+                       }
+                     }
+                     frame.put(std::move(jets), "bench");
+                   }});
+
+  // Associations and the links that replace them, between the same collections
+  cases.push_back({"edm4eic::MCRecoParticleAssociation", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& particles = frame.put(reconstructed_particles(config, rng), "bench_particles");
+                     const auto& mc_particles = frame.put(bench::mc_particles(config, rng), "bench_mc_particles");
+                     frame.put(particle_associations(config, rng, particles, mc_particles), "bench");
+                   }});
+  cases.push_back({"edm4eic::MCRecoParticleLink", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& particles = frame.put(reconstructed_particles(config, rng), "bench_particles");
+                     const auto& mc_particles = frame.put(bench::mc_particles(config, rng), "bench_mc_particles");
+                     frame.put(links<edm4eic::MCRecoParticleLinkCollection>(config, rng, particles, mc_particles), "bench");
+                   }});
+  cases.push_back({"edm4eic::MCRecoClusterParticleAssociation", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& hits = frame.put(calorimeter_hits(config, rng), "bench_hits");
+                     const auto& clusters = frame.put(bench::clusters(config, rng, hits), "bench_clusters");
+                     const auto& mc_particles = frame.put(bench::mc_particles(config, rng), "bench_mc_particles");
+                     frame.put(rec_sim_associations<edm4eic::MCRecoClusterParticleAssociationCollection>(config, rng, clusters, mc_particles),
+                               "bench");
+                   }});
+  cases.push_back({"edm4eic::MCRecoClusterParticleLink", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& hits = frame.put(calorimeter_hits(config, rng), "bench_hits");
+                     const auto& clusters = frame.put(bench::clusters(config, rng, hits), "bench_clusters");
+                     const auto& mc_particles = frame.put(bench::mc_particles(config, rng), "bench_mc_particles");
+                     frame.put(links<edm4eic::MCRecoClusterParticleLinkCollection>(config, rng, clusters, mc_particles), "bench");
+                   }});
+  cases.push_back({"edm4eic::MCRecoTrackParticleAssociation", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& tracks = frame.put(bench::tracks(config, rng), "bench_tracks");
+                     const auto& mc_particles = frame.put(bench::mc_particles(config, rng), "bench_mc_particles");
+                     frame.put(rec_sim_associations<edm4eic::MCRecoTrackParticleAssociationCollection>(config, rng, tracks, mc_particles),
+                               "bench");
+                   }});
+  cases.push_back({"edm4eic::MCRecoTrackParticleLink", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& tracks = frame.put(bench::tracks(config, rng), "bench_tracks");
+                     const auto& mc_particles = frame.put(bench::mc_particles(config, rng), "bench_mc_particles");
+                     frame.put(links<edm4eic::MCRecoTrackParticleLinkCollection>(config, rng, tracks, mc_particles), "bench");
+                   }});
+  cases.push_back({"edm4eic::MCRecoVertexParticleAssociation", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& particles = frame.put(reconstructed_particles(config, rng), "bench_particles");
+                     const auto& vertices = frame.put(bench::vertices(config, rng, particles), "bench_vertices");
+                     const auto& mc_particles = frame.put(bench::mc_particles(config, rng), "bench_mc_particles");
+                     frame.put(rec_sim_associations<edm4eic::MCRecoVertexParticleAssociationCollection>(config, rng, vertices, mc_particles),
+                               "bench");
+                   }});
+  cases.push_back({"edm4eic::MCRecoVertexParticleLink", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& particles = frame.put(reconstructed_particles(config, rng), "bench_particles");
+                     const auto& vertices = frame.put(bench::vertices(config, rng, particles), "bench_vertices");
+                     const auto& mc_particles = frame.put(bench::mc_particles(config, rng), "bench_mc_particles");
+                     frame.put(links<edm4eic::MCRecoVertexParticleLinkCollection>(config, rng, vertices, mc_particles), "bench");
+                   }});
+  cases.push_back({"edm4eic::MCRecoTrackerHitLink", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& raw_hits = frame.put(raw_tracker_hits(config, rng), "bench_raw_hits");
+                     const auto& sim_hits = frame.put(sim_tracker_hits(config, rng), "bench_sim_hits");
+                     frame.put(links<edm4eic::MCRecoTrackerHitLinkCollection>(config, rng, raw_hits, sim_hits), "bench");
+                   }});
+  cases.push_back({"edm4eic::MCRecoCalorimeterHitAssociation", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& raw_hits = frame.put(raw_calorimeter_hits(config, rng), "bench_raw_hits");
+                     const auto& sim_hits = frame.put(sim_calorimeter_hits(config, rng), "bench_sim_hits");
+                     edm4eic::MCRecoCalorimeterHitAssociationCollection associations;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto association = associations.create();
+                       association.setWeight(uniform(rng, 0, 1));
+                       association.setRawHit(raw_hits[i]);
+                       association.setSimHit(sim_hits[i]);
+                     }
+                     frame.put(std::move(associations), "bench");
+                   }});
+  cases.push_back({"edm4eic::MCRecoCalorimeterHitLink", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& raw_hits = frame.put(raw_calorimeter_hits(config, rng), "bench_raw_hits");
+                     const auto& sim_hits = frame.put(sim_calorimeter_hits(config, rng), "bench_sim_hits");
+                     frame.put(links<edm4eic::MCRecoCalorimeterHitLinkCollection>(config, rng, raw_hits, sim_hits), "bench");
+                   }});
+  cases.push_back({"edm4eic::TrackClusterMatch", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& hits = frame.put(calorimeter_hits(config, rng), "bench_hits");
+                     const auto& clusters = frame.put(bench::clusters(config, rng, hits), "bench_clusters");
+                     const auto& tracks = frame.put(bench::tracks(config, rng), "bench_tracks");
+                     edm4eic::TrackClusterMatchCollection matches;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto match = matches.create();
+                       match.setWeight(uniform(rng, 0, 1));
+                       match.setCluster(clusters[i]);
+                       match.setTrack(tracks[targets(config, tracks.size(), rng).at(0)]);
+                     }
+                     frame.put(std::move(matches), "bench");
+                   }});
+  cases.push_back({"edm4eic::TrackClusterLink", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& hits = frame.put(calorimeter_hits(config, rng), "bench_hits");
+                     const auto& clusters = frame.put(bench::clusters(config, rng, hits), "bench_clusters");
+                     const auto& tracks = frame.put(bench::tracks(config, rng), "bench_tracks");
+                     frame.put(links<edm4eic::TrackClusterLinkCollection>(config, rng, clusters, tracks), "bench");
+                   }});
+  cases.push_back({"edm4eic::TrackProtoClusterMatch", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& hits = frame.put(calorimeter_hits(config, rng), "bench_hits");
+                     const auto& protoclusters = frame.put(bench::protoclusters(config, rng, hits), "bench_protoclusters");
+                     const auto& tracks = frame.put(bench::tracks(config, rng), "bench_tracks");
+                     edm4eic::TrackProtoClusterMatchCollection matches;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto match = matches.create();
+                       match.setWeight(uniform(rng, 0, 1));
+                       match.setFrom(tracks[i]);
+                       match.setTo(protoclusters[targets(config, protoclusters.size(), rng).at(0)]);
+                     }
+                     frame.put(std::move(matches), "bench");
+                   }});
+  cases.push_back({"edm4eic::TrackProtoClusterLink", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& hits = frame.put(calorimeter_hits(config, rng), "bench_hits");
+                     const auto& protoclusters = frame.put(bench::protoclusters(config, rng, hits), "bench_protoclusters");
+                     const auto& tracks = frame.put(bench::tracks(config, rng), "bench_tracks");
+                     frame.put(links<edm4eic::TrackProtoClusterLinkCollection>(config, rng, tracks, protoclusters), "bench");
+                   }});
+  cases.push_back({"edm4eic::Truthiness", [](podio::Frame& frame, const bench_config& config, std::mt19937& rng) {
+                     const auto& particles = frame.put(reconstructed_particles(config, rng), "bench_particles");
+                     const auto& mc_particles = frame.put(bench::mc_particles(config, rng), "bench_mc_particles");
+                     const auto& associations =
+                         frame.put(particle_associations(config, rng, particles, mc_particles), "bench_associations");
+                     edm4eic::TruthinessCollection truthinesses;
+                     for (unsigned i = 0; i < config.hits; ++i) {
+                       auto truthiness = truthinesses.create();
+                       truthiness.setTruthiness(uniform(rng, 0, 10));
+                       truthiness.setAssociationContribution({uniform(rng, 0, 1), uniform(rng, 0, 1), uniform(rng, 0, 1)});
+                       truthiness.setUnassociatedMCParticlesContribution(uniform(rng, 0, 1));
+                       truthiness.setUnassociatedRecoParticlesContribution(uniform(rng, 0, 1));
+                       for (auto index : targets(config, associations.size(), rng)) {
+                         truthiness.addToAssociationContributions({uniform(rng, 0, 1), uniform(rng, 0, 1), uniform(rng, 0, 1)});
+                         truthiness.addToAssociations(associations[index]);
+                       }
+                       truthiness.addToUnassociatedMCParticles(mc_particles[targets(config, mc_particles.size(), rng).at(0)]);
+                       truthiness.addToUnassociatedRecoParticles(particles[targets(config, particles.size(), rng).at(0)]);
+                     }
+                     frame.put(std::move(truthinesses), "bench");
+                   }});
+
+  return cases;
+}
+
+// Write and read back `config.events` events of one datatype
+template <class WriterT, class ReaderT>
+bench_result run_case(const bench_case& benchmark, const bench_config& config, const std::string& filename) {
+  using clock = std::chrono::steady_clock;
+  bench_result result;
+  result.start_rss_kb = current_rss_kb();
+  std::mt19937 rng{1};
+
+  {
+    WriterT writer(filename);
+    for (unsigned i = 0; i < config.events; ++i) {
+      auto event = podio::Frame();
+      benchmark.fill(event, config, rng);
+      result.objects += event.get("bench")->size();
+      const auto start = clock::now();
+      writer.writeFrame(event, "events");
+      result.write_seconds += std::chrono::duration<double>(clock::now() - start).count();
+    }
+    const auto start = clock::now();
+    writer.finish();
+    result.write_seconds += std::chrono::duration<double>(clock::now() - start).count();
+  }
+  result.file_bytes = std::filesystem::file_size(filename);
+
+  const auto start = clock::now();
+  ReaderT reader;
+  reader.openFile(filename);
+  const unsigned entries = reader.getEntries("events");
+  std::size_t objects = 0;
+  for (unsigned i = 0; i < entries; ++i) {
+    const auto event = podio::Frame(reader.readNextEntry("events"));
+    // unpack every collection, as an analysis touching all of them would
+    for (const auto& name : event.getAvailableCollections()) {
+      objects += event.get(name)->size();
+    }
+  }
+  result.read_seconds = std::chrono::duration<double>(clock::now() - start).count();
+  if (objects == 0 && result.objects > 0) {
+    throw std::runtime_error("no objects read back for " + benchmark.datatype);
+  }
+  return result;
+}
+
+// run_case in a child process, so that the peak resident set (ru_maxrss
+// only ever grows within a process) is that of this case alone. It still
+// includes the resident set inherited at the fork, reported as start_rss_kb
+template <class WriterT, class ReaderT>
+bench_result run_case_isolated(const bench_case& benchmark, const bench_config& config, const std::string& filename) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    throw std::runtime_error("cannot create a pipe for " + benchmark.datatype);
+  }
+  std::fflush(stdout);
+  const pid_t pid = fork();
+  if (pid < 0) {
+    throw std::runtime_error("cannot fork for " + benchmark.datatype);
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    int status = 1;
+    try {
+      const auto result = run_case<WriterT, ReaderT>(benchmark, config, filename);
+      if (write(fds[1], &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result))) {
+        status = 0;
+      }
+    } catch (const std::exception& e) {
+      std::fprintf(stderr, "%s\n", e.what());
+    }
+    close(fds[1]);
+    std::fflush(stdout);
+    _exit(status);
+  }
+
+  close(fds[1]);
+  bench_result result;
+  const auto bytes = read(fds[0], &result, sizeof(result));
+  close(fds[0]);
+  int status = 0;
+  rusage usage{};
+  if (wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0 ||
+      bytes != static_cast<ssize_t>(sizeof(result))) {
+    throw std::runtime_error("benchmark of " + benchmark.datatype + " did not complete");
+  }
+  result.peak_rss_kb = usage.ru_maxrss;
+  return result;
+}
+
+// One JSON object per line, so that results can be collected by scripts
+inline void print_result(const std::string& backend, const bench_case& benchmark, const bench_config& config,
+                         const bench_result& result) {
+  const double mb = static_cast<double>(result.file_bytes) / 1e6;
+  std::printf("{\"backend\": \"%s\", \"datatype\": \"%s\", \"events\": %u, \"objects\": %zu, "
+              "\"fanout\": %u, \"samples\": %u, \"file_bytes\": %ju, \"bytes_per_object\": %.2f, "
+              "\"write_events_per_s\": %.1f, \"write_MB_per_s\": %.2f, "
+              "\"read_events_per_s\": %.1f, \"read_MB_per_s\": %.2f, \"start_rss_kB\": %ld, \"peak_rss_kB\": %ld}\n",
+              backend.c_str(), benchmark.datatype.c_str(), config.events, result.objects, config.fanout,
+              config.samples, result.file_bytes,
+              result.objects > 0 ? static_cast<double>(result.file_bytes) / result.objects : 0.,
+              config.events / result.write_seconds, mb / result.write_seconds, config.events / result.read_seconds,
+              mb / result.read_seconds, result.start_rss_kb, result.peak_rss_kb);
+  std::fflush(stdout);
+}
+
+#endif
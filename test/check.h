@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef EDM4EIC_TEST_CHECK_H
+#define EDM4EIC_TEST_CHECK_H
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// Checks for the unit tests of the utilities; a failing check throws, which fails the test
+inline void check(bool condition, const std::string& what) {
+  if (!condition) {
+    throw std::runtime_error("check failed: " + what);
+  }
+}
+
+inline void check_close(double value, double expected, double tolerance, const std::string& what) {
+  if (!(std::fabs(value - expected) <= tolerance)) {
+    throw std::runtime_error("check failed: " + what + ": " + std::to_string(value) + " instead of " +
+                             std::to_string(expected) + " +- " + std::to_string(tolerance));
+  }
+}
+
+template <typename ExceptionT, typename F> void check_throws(F&& f, const std::string& what) {
+  try {
+    f();
+  } catch (const ExceptionT&) {
+    return;
+  }
+  throw std::runtime_error("check failed: " + what + " did not throw");
+}
+
+#endif
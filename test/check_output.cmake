@@ -0,0 +1,37 @@
+# SPDX-License-Identifier: Apache-2.0
+
+# Run a command, and fail on a non-zero exit code or if its output does not
+# match a regular expression; ctest itself ignores the exit code of a test
+# with PASS_REGULAR_EXPRESSION.
+#
+#   cmake -DEXPECTED=<regex> -P check_output.cmake -- <command> [<arg>...]
+
+cmake_minimum_required(VERSION 3.12)
+
+set(command)
+set(in_command FALSE)
+math(EXPR last "${CMAKE_ARGC} - 1")
+foreach(i RANGE ${last})
+  if(in_command)
+    list(APPEND command "${CMAKE_ARGV${i}}")
+  elseif("${CMAKE_ARGV${i}}" STREQUAL "--")
+    set(in_command TRUE)
+  endif()
+endforeach()
+if(NOT command)
+  message(FATAL_ERROR "check_output.cmake: no command after --")
+endif()
+
+execute_process(COMMAND ${command}
+  OUTPUT_VARIABLE output
+  ERROR_VARIABLE output
+  RESULT_VARIABLE result)
+message("${output}")
+
+if(NOT result EQUAL 0)
+  string(JOIN " " command_line ${command})
+  message(FATAL_ERROR "check_output.cmake: ${command_line} exited with ${result}")
+endif()
+if(DEFINED EXPECTED AND NOT output MATCHES "${EXPECTED}")
+  message(FATAL_ERROR "check_output.cmake: output does not match '${EXPECTED}'")
+endif()
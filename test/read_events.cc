@@ -2,6 +2,8 @@
 
 #include "read_events.h"
 
+#include <TROOT.h>
+
 #include <podio/podioVersion.h>
 #if PODIO_BUILD_VERSION >= PODIO_VERSION(0, 99, 0)
 #include <podio/ROOTReader.h>
@@ -12,8 +14,24 @@ using ROOTReader = podio::ROOTFrameReader;
 }
 #endif
 
-int main() {
-  read_events<podio::ROOTReader>("edm4eic_events.root");
+// Usage: read_events [file], by default the files written by write_events
+int main(int argc, char* argv[]) {
+  if (argc > 1) {
+    if (read_events<podio::ROOTReader>(argv[1]) == 0) {
+      throw std::runtime_error(std::string("no events in ") + argv[1]);
+    }
+    return 0;
+  }
+
+  const unsigned nEvents = read_events<podio::ROOTReader>("edm4eic_events.root");
+
+  // the same events, written through edm4eic::async_writer
+  if (read_events<podio::ROOTReader>("edm4eic_events_async.root") != nEvents) {
+    throw std::runtime_error("asynchronously written file has a different number of events");
+  }
+
+  ROOT::EnableThreadSafety();
+  read_events_parallel<podio::ROOTReader>("edm4eic_events.root", 4);
 
   return 0;
 }
@@ -4,6 +4,7 @@
 #define EDM4EIC_TEST_READ_EVENTS_H__
 
 // test data model
+#include "edm4eic/MCRecoTrackerHitAssociationCollection.h"
 #include "edm4eic/RawTrackerHitCollection.h"
 
 // podio specific includes
@@ -11,11 +12,15 @@
 #include "podio/podioVersion.h"
 
 // STL
+#include <algorithm>
 #include <cassert>
 #include <exception>
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 
+#include <edm4eic/parallel_reader.h>
+
 void processEvent(const podio::Frame& event, bool verboser, unsigned eventNum) {
   auto& raw_hits = event.get<edm4eic::RawTrackerHitCollection>("RawTrackerHits");
 
@@ -42,6 +47,20 @@ void processEvent(const podio::Frame& event, bool verboser, unsigned eventNum) {
     throw std::runtime_error("Collection 'RawTrackerHits' should be present");
   }
 
+  // relations resolve, also when the collection they point into was skimmed away
+  const auto available = event.getAvailableCollections();
+  const auto has = [&available](const std::string& name) {
+    return std::find(available.begin(), available.end(), name) != available.end();
+  };
+  if (has("RawTrackerHitAssociations")) {
+    auto& associations = event.get<edm4eic::MCRecoTrackerHitAssociationCollection>("RawTrackerHitAssociations");
+    const auto association = associations[0];
+    if (association.getRawHit().getCellID() != 0x0123456789abcdefLL)
+      throw std::runtime_error("association does not point to the first hit");
+    if (has("SimTrackerHits") != association.getSimHit().isAvailable())
+      throw std::runtime_error("association to the SimTrackerHits resolves only if they are present");
+  }
+
   //===============================================================================
 
   const auto& evtType = event.getParameter<std::string>("EventType");
@@ -53,7 +72,7 @@ void processEvent(const podio::Frame& event, bool verboser, unsigned eventNum) {
 }
 
 template <typename ReaderT>
-void read_events(const std::string& filename) {
+unsigned read_events(const std::string& filename) {
   ReaderT reader;
   reader.openFile(filename);
 
@@ -63,6 +82,24 @@ void read_events(const std::string& filename) {
     const auto event = podio::Frame(reader.readNextEntry("events"));
     processEvent(event, true, i);
   }
+  return nEvents;
+}
+
+template <typename ReaderT>
+void read_events_parallel(const std::string& filename, unsigned threads) {
+  edm4eic::parallel_reader<ReaderT> reader({filename}, threads, "events", 2);
+
+  unsigned nEvents = 0;
+  reader.run(
+      [&nEvents](const podio::Frame& event, std::size_t i) {
+        std::cout << "reading event " << i << " in parallel" << std::endl;
+        processEvent(event, true, i);
+        ++nEvents;
+      },
+      edm4eic::read_completion::ordered);
+  if (nEvents != reader.entries()) {
+    throw std::runtime_error("parallel reader did not deliver all events");
+  }
 }
 
 #endif
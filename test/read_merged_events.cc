@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <podio/Frame.h>
+#include <podio/ROOTReader.h>
+
+#include "edm4hep/EDM4hepVersion.h"
+#include "edm4hep/MCParticleCollection.h"
+#include "edm4hep/SimTrackerHitCollection.h"
+
+#include "check.h"
+#include "write_events.h"
+
+namespace {
+
+edm4hep::MCParticle particle_of(const edm4hep::SimTrackerHit& hit) {
+#if EDM4HEP_BUILD_VERSION >= EDM4HEP_VERSION(0, 99, 0)
+  return hit.getParticle();
+#else
+  return hit.getMCParticle();
+#endif
+}
+
+// every spliced event adds one hit and the two particles of its decay, and
+// the relations between them point into the merged collections
+void check_relations(const edm4hep::SimTrackerHitCollection& hits, const edm4hep::MCParticleCollection& particles) {
+  check(particles.size() == 2 * hits.size(), "two particles per hit");
+  for (std::size_t k = 0; k < hits.size(); ++k) {
+    const auto daughter = particle_of(hits[k]);
+    check(daughter.isAvailable() && daughter.getObjectID().collectionID == particles.getID() &&
+              daughter.getObjectID().index == static_cast<int>(2 * k + 1),
+          "hit related to the daughter of its own event");
+    check(daughter.getParents().size() == 1 && daughter.getParents()[0] == particles[2 * k], "parent of the daughter");
+    const auto parent = particles[2 * k];
+    check(parent.getParents().empty() && parent.getDaughters().size() == 1 && parent.getDaughters()[0] == daughter,
+          "daughter of the parent");
+  }
+}
+
+// events placed on the bunch crossings of time frames of `length` [ns]
+void check_time_frames(podio::ROOTReader& reader, std::size_t entries, double length, double spacing) {
+  std::size_t events = 0;
+  bool shifted = false;
+  for (std::size_t i = 0; i < entries; ++i) {
+    const auto frame = podio::Frame(reader.readNextEntry("events"));
+    check(frame.getParameter<double>("TimeFrameStart") == static_cast<double>(i) * length &&
+              frame.getParameter<double>("TimeFrameLength") == length,
+          "time frame parameters");
+    const auto& hits = frame.get<edm4hep::SimTrackerHitCollection>("SimTrackerHits");
+    const auto& particles = frame.get<edm4hep::MCParticleCollection>("MCParticles");
+    check_relations(hits, particles);
+
+    // all objects of an event are shifted by its time in the frame, a bunch crossing
+    for (std::size_t k = 0; k < hits.size(); ++k) {
+      const double offset = hits[k].getTime() - sim_hit_time;
+      check(offset >= -1e-3 && offset < length, "event within the time frame");
+      check_close(offset, spacing * std::round(offset / spacing), 1e-3, "event on a bunch crossing");
+      check_close(particles[2 * k].getTime() - mc_particle_time, offset, 1e-3, "parent shifted with the hit");
+      check_close(particles[2 * k + 1].getTime() - mc_particle_time, offset, 1e-3, "daughter shifted with the hit");
+      shifted = shifted || offset > 0;
+    }
+    events += hits.size();
+  }
+  check(shifted, "events shifted into the time frames");
+  check(events >= 10, "all signal events in the time frames");
+}
+
+} // namespace
+
+// Usage: read_merged_events file background_events
+//        read_merged_events file --time-frame length bunch_spacing
+// for edm4eic_events.root merged with itself as background, in the second
+// case into time frames, with sequential sampling
+int main(int argc, char* argv[]) {
+  const bool time_frames = argc == 5 && std::string(argv[2]) == "--time-frame";
+  if (argc != 3 && !time_frames) {
+    std::cerr << "Usage: " << argv[0] << " file background_events" << std::endl;
+    std::cerr << "       " << argv[0] << " file --time-frame length bunch_spacing" << std::endl;
+    return 1;
+  }
+  const std::string file{argv[1]};
+
+  podio::ROOTReader reader;
+  reader.openFile(file);
+  const std::size_t entries = reader.getEntries("events");
+  check(entries > 0, "merged events");
+
+  if (time_frames) {
+    check_time_frames(reader, entries, std::stod(argv[3]), std::stod(argv[4]));
+    std::cout << "Checked " << entries << " time frames of " << file << std::endl;
+    return 0;
+  }
+
+  const auto backgrounds = static_cast<std::size_t>(std::stoul(argv[2]));
+  for (std::size_t i = 0; i < entries; ++i) {
+    const auto event = podio::Frame(reader.readNextEntry("events"));
+    const auto& hits = event.get<edm4hep::SimTrackerHitCollection>("SimTrackerHits");
+    const auto& particles = event.get<edm4hep::MCParticleCollection>("MCParticles");
+    check(hits.size() == 1 + backgrounds, "signal hit followed by the background hits");
+    check_relations(hits, particles);
+
+    // the energy deposit is the number of the event the hit comes from
+    check(hits[0].getEDep() == static_cast<float>(i), "signal hit first");
+    for (std::size_t k = 1; k < hits.size(); ++k) {
+      check(hits[k].getEDep() == static_cast<float>((backgrounds * i + k - 1) % entries),
+            "background events in file order");
+    }
+    for (std::size_t k = 0; k < hits.size(); ++k) {
+      check(hits[k].getTime() == sim_hit_time && particles[2 * k].getTime() == mc_particle_time,
+            "times of overlaid events unchanged");
+    }
+  }
+
+  std::cout << "Checked " << entries << " merged events of " << file << std::endl;
+  return 0;
+}
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include <edm4eic/analysis_utils.h>
+
+#include "check.h"
+
+namespace {
+
+void test_sincos() {
+  // the documented bound holds for |x| < 100, which covers any theta and phi
+  double max_error = 0;
+  for (float x = -100.f; x < 100.f; x += 1.3e-4f) {
+    float s, c;
+    edm4eic::detail::sincos_fast(x, s, c);
+    max_error = std::max({max_error, std::fabs(s - std::sin(double(x))), std::fabs(c - std::cos(double(x)))});
+  }
+  check_close(max_error, 0, 1e-7, "sincos_fast against std::sin and std::cos");
+
+  // quadrant boundaries
+  for (int k = -8; k <= 8; ++k) {
+    const float x = static_cast<float>(k * std::numbers::pi / 4);
+    float s, c;
+    edm4eic::detail::sincos_fast(x, s, c);
+    check_close(s, std::sin(double(x)), 1e-7, "sin at k pi/4");
+    check_close(c, std::cos(double(x)), 1e-7, "cos at k pi/4");
+  }
+}
+
+void test_momenta() {
+  std::vector<edm4eic::TrackParametersData> tracks;
+  std::vector<float> theta, phi, qOverP;
+  for (int i = 0; i < 1000; ++i) {
+    edm4eic::TrackParametersData track{};
+    track.theta = static_cast<float>(std::numbers::pi * (i + 0.5) / 1000);
+    track.phi = static_cast<float>(std::numbers::pi * (2. * ((i * 37) % 1000) / 1000 - 1));
+    track.qOverP = (i % 2 ? 1.f : -1.f) / (0.1f + 0.05f * static_cast<float>(i % 200));
+    if (i == 500) {
+      track.qOverP = 0; // no momentum, as in the scalar version
+    }
+    tracks.push_back(track);
+    theta.push_back(track.theta);
+    phi.push_back(track.phi);
+    qOverP.push_back(track.qOverP);
+  }
+  const auto expected = edm4eic::momenta_from_tracking(tracks, 0.13957);
+
+  const std::size_t n = tracks.size();
+  const std::vector<double> masses{0.13957, 0.93827};
+  std::vector<double> px(n), py(n), pz(n), energy(2 * n);
+  edm4eic::momenta_from_tracking(theta, phi, qOverP, masses, px, py, pz, energy);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    // single precision trigonometry and 1 / qOverP
+    const double p = std::fabs(qOverP[i]) < 1e-9 ? 0 : 1. / std::fabs(qOverP[i]);
+    const double tolerance = 1e-6 * p + 1e-12;
+    check_close(px[i], expected[i].Px(), tolerance, "px");
+    check_close(py[i], expected[i].Py(), tolerance, "py");
+    check_close(pz[i], expected[i].Pz(), tolerance, "pz");
+    for (std::size_t m = 0; m < masses.size(); ++m) {
+      check_close(energy[m * n + i], std::sqrt(p * p + masses[m] * masses[m]), tolerance, "energy");
+    }
+  }
+  check(px[500] == 0 && py[500] == 0 && pz[500] == 0, "zero qOverP gives zero momentum");
+
+  check_throws<std::invalid_argument>(
+      [&] {
+        edm4eic::momenta_from_tracking(theta, phi, qOverP, masses, px, py, pz, std::span<double>{energy.data(), n});
+      },
+      "too small energy buffer");
+}
+
+} // namespace
+
+int main() {
+  test_sincos();
+  test_momenta();
+  std::cout << "analysis utils checks passed" << std::endl;
+  return 0;
+}
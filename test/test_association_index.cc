@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+#include <edm4eic/MCRecoParticleAssociationCollection.h>
+#include <edm4eic/ReconstructedParticleCollection.h>
+#include <edm4eic/TrackClusterMatchCollection.h>
+#include <edm4eic/association_index.h>
+#include <edm4hep/MCParticleCollection.h>
+
+#include "check.h"
+
+// cluster/track ends are supported, collections of non-associations are rejected
+static_assert(std::is_constructible_v<edm4eic::association_index, const edm4eic::TrackClusterMatchCollection&>);
+static_assert(!std::is_constructible_v<edm4eic::association_index, const edm4eic::ReconstructedParticleCollection&>);
+
+namespace {
+
+bool same(const podio::ObjectID a, const podio::ObjectID b) {
+  return a.index == b.index && a.collectionID == b.collectionID;
+}
+
+} // namespace
+
+int main() {
+  edm4hep::MCParticleCollection sims;
+  sims.setID(1);
+  edm4eic::ReconstructedParticleCollection recs;
+  recs.setID(2);
+  for (int i = 0; i < 4; ++i) {
+    sims.create();
+  }
+  for (int i = 0; i < 3; ++i) {
+    recs.create();
+  }
+
+  // rec 0 -> sim 0 (0.2), sim 1 (0.7); rec 1 -> sim 1 (0.5), sim 2 (0.1); rec 2 unmatched
+  edm4eic::MCRecoParticleAssociationCollection assocs;
+  const auto add = [&](int rec, int sim, float weight) {
+    auto assoc = assocs.create();
+    if (rec >= 0) {
+      assoc.setRec(recs[rec]);
+    }
+    if (sim >= 0) {
+      assoc.setSim(sims[sim]);
+    }
+    assoc.setWeight(weight);
+  };
+  add(0, 0, 0.2f);
+  add(1, 2, 0.1f);
+  add(0, 1, 0.7f);
+  add(1, 1, 0.5f);
+  add(1, -1, 0.9f); // no sim end
+
+  // ends that are not in any collection, available but without an index
+  const edm4hep::MutableMCParticle untracked_sim;
+  const edm4eic::MutableReconstructedParticle untracked_rec;
+  auto to_untracked = assocs.create();
+  to_untracked.setRec(recs[2]);
+  to_untracked.setSim(untracked_sim);
+  to_untracked.setWeight(0.3f);
+  auto from_untracked = assocs.create();
+  from_untracked.setRec(untracked_rec);
+  from_untracked.setSim(sims[3]);
+  from_untracked.setWeight(0.4f);
+
+  const edm4eic::association_index index(assocs);
+  check(index.incomplete() == 3, "associations without a sim end or with untracked ends are skipped");
+  check(index.rec_of(untracked_sim.getObjectID()).empty() && index.sim_of(untracked_rec.getObjectID()).empty(),
+        "no matches of untracked objects");
+
+  const auto sim_of_rec0 = index.sim_of(recs[0]);
+  check(sim_of_rec0.size() == 2, "two sims of rec 0");
+  check(same(sim_of_rec0[0].id, sims[1].getObjectID()) && sim_of_rec0[0].weight == 0.7f &&
+            sim_of_rec0[0].association == 2,
+        "highest weight sim of rec 0 first");
+  check(same(sim_of_rec0[1].id, sims[0].getObjectID()) && sim_of_rec0[1].weight == 0.2f &&
+            sim_of_rec0[1].association == 0,
+        "lower weight sim of rec 0 second");
+
+  const auto sim_of_rec1 = index.sim_of(recs[1]);
+  check(sim_of_rec1.size() == 2 && same(sim_of_rec1[0].id, sims[1].getObjectID()) &&
+            same(sim_of_rec1[1].id, sims[2].getObjectID()),
+        "sims of rec 1 by decreasing weight, without the incomplete association");
+  check(index.sim_of(recs[2]).empty(), "unmatched rec");
+
+  const auto rec_of_sim1 = index.rec_of(sims[1]);
+  check(rec_of_sim1.size() == 2, "two recs of sim 1");
+  check(same(rec_of_sim1[0].id, recs[0].getObjectID()) && rec_of_sim1[0].weight == 0.7f,
+        "highest weight rec of sim 1 first");
+  check(same(rec_of_sim1[1].id, recs[1].getObjectID()) && rec_of_sim1[1].weight == 0.5f,
+        "lower weight rec of sim 1 second");
+  check(index.rec_of(sims[0]).size() == 1 && index.rec_of(sims[2]).size() == 1, "one rec of sims 0 and 2");
+  check(index.rec_of(sims[3]).empty(), "unmatched sim");
+
+  const auto best = index.best_rec(sims[2]);
+  check(best.has_value() && same(best->id, recs[1].getObjectID()) && best->association == 1, "best rec of sim 2");
+  check(!index.best_sim(recs[2]).has_value(), "no best sim of an unmatched rec");
+
+  // objects of another collection, or past the end of a known one
+  check(index.sim_of(podio::ObjectID{0, 3}).empty(), "unknown collection");
+  check(index.rec_of(podio::ObjectID{7, 1}).empty(), "index past the matched objects");
+
+  std::cout << "association_index checks passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <podio/Frame.h>
+
+#include <edm4eic/async_writer.h>
+
+#include "check.h"
+
+namespace {
+
+// Records what it was asked to write, and fails on the frame with index `fail_at`
+struct recording_writer {
+  struct log {
+    std::vector<int> written;
+    unsigned finished = 0;
+  };
+
+  recording_writer(log& l, int fail) : output{l}, fail_at{fail} {}
+
+  void writeFrame(const podio::Frame& frame, const std::string& category) {
+    const int index = frame.getParameter<int>("index").value_or(-1);
+    if (category != "events" || index == fail_at) {
+      throw std::runtime_error("cannot write frame " + std::to_string(index));
+    }
+    output.written.push_back(index);
+  }
+  void writeFrame(const podio::Frame& frame, const std::string& category, const std::vector<std::string>&) {
+    writeFrame(frame, category);
+  }
+  void finish() { ++output.finished; }
+
+  log& output;
+  int fail_at;
+};
+
+podio::Frame frame(int index) {
+  podio::Frame frame;
+  frame.putParameter("index", index);
+  return frame;
+}
+
+void test_order() {
+  recording_writer::log output;
+  {
+    edm4eic::async_writer<recording_writer> writer(2, output, -1);
+    for (int i = 0; i < 20; ++i) {
+      writer.writeFrame(frame(i), "events");
+    }
+    writer.finish();
+    check(output.finished == 1, "wrapped writer finished once");
+    writer.finish();
+  }
+  check(output.written.size() == 20, "all frames written");
+  for (int i = 0; i < 20; ++i) {
+    check(output.written[i] == i, "frames written in submission order");
+  }
+  check(output.finished == 1, "finish() and the destructor finish the wrapped writer once");
+}
+
+void test_error() {
+  recording_writer::log output;
+  edm4eic::async_writer<recording_writer> writer(4, output, 3);
+  try {
+    for (int i = 0; i < 6; ++i) {
+      writer.writeFrame(frame(i), "events");
+    }
+  } catch (const std::runtime_error&) {
+    // the failure may already be seen by a later writeFrame()
+  }
+  check_throws<std::runtime_error>([&] { writer.finish(); }, "finish() rethrows the write failure");
+  // the frames before the failing one are in the output, which is closed
+  check(output.written == std::vector<int>{0, 1, 2}, "frames before the failure written");
+  check(output.finished == 1, "wrapped writer finished before the failure is rethrown");
+  check_throws<std::runtime_error>([&] { writer.finish(); }, "later finish() rethrows again");
+  check(output.finished == 1, "wrapped writer finished once");
+  check_throws<std::logic_error>([&] { writer.writeFrame(frame(7), "events"); }, "writeFrame() after finish()");
+}
+
+} // namespace
+
+int main() {
+  test_order();
+  test_error();
+  std::cout << "async_writer checks passed" << std::endl;
+  return 0;
+}
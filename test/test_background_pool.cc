@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <podio/Frame.h>
+#include <podio/ROOTReader.h>
+#include <podio/ROOTWriter.h>
+
+#include <edm4eic/RawTrackerHitCollection.h>
+#include <edm4eic/background_pool.h>
+
+#include "check.h"
+
+namespace {
+
+using edm4eic::background_reuse;
+using edm4eic::background_sampler;
+using edm4eic::background_sampling;
+
+// entries drawn for `events` consecutive signal events
+std::vector<std::vector<std::size_t>> draw(background_sampler sampler, int events) {
+  std::vector<std::vector<std::size_t>> draws;
+  for (int i = 0; i < events; ++i) {
+    draws.push_back(sampler.next());
+  }
+  return draws;
+}
+
+void test_sampler() {
+  // sequential sampling wraps around the entries
+  const auto sequential = draw(background_sampler{5, 3, background_sampling::sequential}, 2);
+  check(sequential == std::vector<std::vector<std::size_t>>{{0, 1, 2}, {3, 4, 0}}, "sequential sampling");
+
+  // the draws depend only on the seed
+  for (const auto sampling : {background_sampling::random, background_sampling::poisson}) {
+    for (const auto reuse : {background_reuse::replace, background_reuse::unique, background_reuse::deck}) {
+      const auto a = draw(background_sampler{50, 4, sampling, reuse, 7}, 20);
+      const auto b = draw(background_sampler{50, 4, sampling, reuse, 7}, 20);
+      const auto c = draw(background_sampler{50, 4, sampling, reuse, 8}, 20);
+      check(a == b, "same draws for the same seed");
+      check(a != c, "other draws for another seed");
+      for (const auto& entries : a) {
+        check(std::all_of(entries.begin(), entries.end(), [](auto e) { return e < 50; }), "entries in range");
+      }
+    }
+  }
+
+  // no entry twice for one signal event, until all entries are used
+  background_sampler unique{10, 8, background_sampling::random, background_reuse::unique, 3};
+  for (int i = 0; i < 100; ++i) {
+    const auto entries = unique.next();
+    check(std::set<std::size_t>(entries.begin(), entries.end()).size() == entries.size(), "unique entries");
+  }
+  const auto all = unique.next(25);
+  check(std::set<std::size_t>(all.begin(), all.begin() + 10).size() == 10, "all entries before repeating");
+
+  // every entry once per pass through the deck, across signal events
+  background_sampler deck{7, 3, background_sampling::random, background_reuse::deck, 5};
+  std::vector<std::size_t> dealt;
+  for (int i = 0; i < 14; ++i) {
+    const auto entries = deck.next();
+    dealt.insert(dealt.end(), entries.begin(), entries.end());
+  }
+  for (std::size_t pass = 0; pass < 6; ++pass) {
+    std::vector<std::size_t> cards(dealt.begin() + 7 * pass, dealt.begin() + 7 * (pass + 1));
+    std::sort(cards.begin(), cards.end());
+    check(cards == std::vector<std::size_t>{0, 1, 2, 3, 4, 5, 6}, "every entry once per deck");
+  }
+
+  // the number of events follows the Poisson mean
+  const double mean = 2.5;
+  const int events = 20000;
+  background_sampler poisson{100, mean, background_sampling::poisson, background_reuse::replace, 11};
+  double sum = 0, sum2 = 0;
+  for (int i = 0; i < events; ++i) {
+    const double count = static_cast<double>(poisson.next().size());
+    sum += count;
+    sum2 += count * count;
+  }
+  const double sample_mean = sum / events;
+  check_close(sample_mean, mean, 4 * std::sqrt(mean / events), "Poisson mean");
+  check_close(sum2 / events - sample_mean * sample_mean, mean, 0.1 * mean, "Poisson variance");
+
+  check(background_sampler{10, 0, background_sampling::poisson}.next().empty(), "no background for mean 0");
+  check_throws<std::invalid_argument>([] { background_sampler(0, 1, background_sampling::random); }, "no entries");
+  check(edm4eic::background_reuse_from_string("deck") == background_reuse::deck, "reuse by name");
+  check_throws<std::invalid_argument>([] { edm4eic::background_sampling_from_string("uniform"); },
+                                      "unknown sampling");
+}
+
+void test_pool() {
+  // six events with 1 to 6 hits
+  {
+    podio::ROOTWriter writer("test_background_pool.root");
+    for (int i = 0; i < 6; ++i) {
+      edm4eic::RawTrackerHitCollection hits;
+      for (int k = 0; k <= i; ++k) {
+        hits.create().setCellID(10 * i + k);
+      }
+      podio::Frame event;
+      event.put(std::move(hits), "RawTrackerHits");
+      writer.writeFrame(event, "events");
+    }
+    writer.finish();
+  }
+
+  podio::ROOTReader reader;
+  reader.openFile("test_background_pool.root");
+  const std::vector<std::string> names{"RawTrackerHits"};
+  std::vector<std::size_t> bytes;
+  for (unsigned i = 0; i < 6; ++i) {
+    bytes.push_back(edm4eic::frame_buffers(reader.readEntry("events", i), names).bytes());
+  }
+
+  const edm4eic::background_pool pool(reader, names, bytes[0] + bytes[1] + bytes[2]);
+  check(pool.size() == 3 && pool.bytes() == bytes[0] + bytes[1] + bytes[2], "first events up to the limit");
+  for (std::size_t i = 0; i < pool.size(); ++i) {
+    const auto* hits = pool[i]->buffers("RawTrackerHits");
+    check(hits != nullptr && edm4eic::find_splice_ops(hits->type)->size(*hits) == i + 1, "pooled event in order");
+  }
+  check(edm4eic::background_pool(reader, names, 0).size() == 1, "at least one event");
+  check(edm4eic::background_pool(reader, names, 1 << 30).size() == 6, "all events");
+}
+
+} // namespace
+
+int main() {
+  test_sampler();
+  test_pool();
+
+  std::cout << "background_pool checks passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <edm4eic/cellid_decoder.h>
+
+#include "check.h"
+
+namespace {
+
+using decoder = edm4eic::cellid_decoder<"system:8,layer:4,x:32:-16,y:-16">;
+
+uint64_t cellID(int64_t system, int64_t layer, int64_t x, int64_t y) {
+  const uint64_t id = *decoder::set<"layer">(*decoder::set<"system">(0, system), layer);
+  return *decoder::set<"y">(*decoder::set<"x">(id, x), y);
+}
+
+} // namespace
+
+// the descriptor is parsed at compile time, with explicit and implicit offsets
+static_assert(decoder::size == 4);
+static_assert(decoder::field<"layer">().offset == 8 && decoder::field<"layer">().width == 4 &&
+              !decoder::field<"layer">().is_signed);
+static_assert(decoder::field<"x">().offset == 32 && decoder::field<"x">().width == 16 &&
+              decoder::field<"x">().is_signed);
+static_assert(decoder::field<"y">().offset == 48 && decoder::field<"y">().width == 16 &&
+              decoder::field<"y">().is_signed);
+
+// signed fields are sign-extended, and set() checks the range of a field
+static_assert(decoder::get<"x">(uint64_t{0xffff} << 32) == -1);
+static_assert(decoder::get<"x">(uint64_t{0x7fff} << 32) == 32767);
+static_assert(decoder::get<"y">(uint64_t{0x8000} << 48) == -32768);
+static_assert(decoder::get<"layer">(0xffff'ffff'ffff'ffff) == 15);
+static_assert(*decoder::set<"x">(0, -5) == uint64_t{0xfffb} << 32);
+static_assert(decoder::get<"x">(*decoder::set<"x">(0xffff'0000'ffff'ffff, -5)) == -5);
+static_assert(!decoder::set<"x">(0, 32768).has_value() && !decoder::set<"x">(0, -32769).has_value());
+static_assert(!decoder::set<"layer">(0, 16).has_value() && !decoder::set<"layer">(0, -1).has_value());
+
+// the masks of Acts::GeometryIdentifier
+static_assert(edm4eic::geometry_id_decoder::field<"volume">().mask() == 0xff00'0000'0000'0000);
+static_assert(edm4eic::geometry_id_decoder::field<"boundary">().mask() == 0x00ff'0000'0000'0000);
+static_assert(edm4eic::geometry_id_decoder::field<"layer">().mask() == 0x0000'fff0'0000'0000);
+static_assert(edm4eic::geometry_id_decoder::field<"approach">().mask() == 0x0000'000f'f000'0000);
+static_assert(edm4eic::geometry_id_decoder::field<"sensitive">().mask() == 0x0000'0000'0fff'ff00);
+static_assert(edm4eic::geometry_id_decoder::field<"extra">().mask() == 0x0000'0000'0000'00ff);
+
+int main() {
+  const std::vector<uint64_t> cellIDs{cellID(1, 2, -3, 0), cellID(1, 1, 2, -7), cellID(1, 2, -1, 5),
+                                      cellID(1, 1, 0, 0),  cellID(1, 2, -3, 1), cellID(1, 1, -32768, 32767)};
+
+  std::vector<int16_t> x(cellIDs.size());
+  decoder::decode<"x", int16_t>(cellIDs, x);
+  check(x == std::vector<int16_t>{-3, 2, -1, 0, -3, -32768}, "batch decoding of a signed field");
+  check_throws<std::invalid_argument>([&] { decoder::decode<"x", int16_t>(cellIDs, std::span<int16_t>{x}.first(2)); },
+                                      "batch of another size");
+
+  const auto columns = decoder::decode(cellIDs);
+  check(columns[1] == std::vector<int64_t>{2, 1, 2, 1, 2, 1}, "column of an unsigned field");
+  check(columns[3] == std::vector<int64_t>{0, -7, 5, 0, 1, 32767}, "column of a signed field");
+
+  // signed fields sort by value, not by their bits; equal keys keep their order
+  check(decoder::sort_by<"x">(cellIDs) == std::vector<uint32_t>{5, 0, 4, 2, 3, 1}, "sort by a signed field");
+  check(decoder::sort_by<"layer", "x">(cellIDs) == std::vector<uint32_t>{5, 3, 1, 0, 4, 2},
+        "sort by layer, then by a signed field");
+  check(decoder::sort_by<"y", "layer">(cellIDs) == std::vector<uint32_t>{1, 3, 0, 4, 2, 5},
+        "sort by a signed field, then by layer");
+
+  // a geometry identifier as composed by Acts
+  const uint64_t geometry_id = (uint64_t{12} << 56) | (uint64_t{3} << 48) | (uint64_t{0x123} << 36) |
+                               (uint64_t{7} << 28) | (uint64_t{0xabcde} << 8) | 0x42;
+  check(edm4eic::geometry_id_decoder::get<"volume">(geometry_id) == 12, "volume of a geometry identifier");
+  check(edm4eic::geometry_id_decoder::get<"boundary">(geometry_id) == 3, "boundary of a geometry identifier");
+  check(edm4eic::geometry_id_decoder::get<"layer">(geometry_id) == 0x123, "layer of a geometry identifier");
+  check(edm4eic::geometry_id_decoder::get<"approach">(geometry_id) == 7, "approach of a geometry identifier");
+  check(edm4eic::geometry_id_decoder::get<"sensitive">(geometry_id) == 0xabcde, "sensitive of a geometry identifier");
+  check(edm4eic::geometry_id_decoder::get<"extra">(geometry_id) == 0x42, "extra of a geometry identifier");
+
+  // the run-time layout agrees with the compile-time decoder
+  const auto& layout = edm4eic::cellid_layout_cache::instance().get(std::string(decoder::descriptor()));
+  check(&layout == &edm4eic::cellid_layout_cache::instance().get(std::string(decoder::descriptor())),
+        "layouts parsed once");
+  for (const auto& field : decoder::fields) {
+    const auto f = layout.field(field.name);
+    check(f.offset == field.field.offset && f.width == field.field.width && f.is_signed == field.field.is_signed,
+          "run-time field " + std::string(field.name));
+  }
+  check(layout.field("x").get(cellIDs[5]) == -32768, "run-time sign extension");
+  check(!layout.find("z").has_value(), "no such run-time field");
+  check_throws<std::out_of_range>([&] { layout.field("z"); }, "unknown run-time field");
+  check_throws<std::invalid_argument>([] { edm4eic::cellid_layout{"system:8,layer"}; }, "field without width");
+  check_throws<std::invalid_argument>([] { edm4eic::cellid_layout{"system:8,x:60:8"}; }, "field beyond 64 bits");
+
+  std::cout << "cellid_decoder checks passed" << std::endl;
+  return 0;
+}
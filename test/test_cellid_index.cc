@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <edm4eic/cellid_index.h>
+
+#include "check.h"
+
+namespace {
+
+// DD4hep-like layout with the volume fields in the low bits: system:8,layer:8,module:8,x:20:-20,y:20:-20
+const edm4eic::cellid_field system_field{0, 8};
+const edm4eic::cellid_field layer_field{8, 8};
+const edm4eic::cellid_field module_field{16, 8};
+const edm4eic::cellid_field x_field{24, 20, true};
+const edm4eic::cellid_field y_field{44, 20, true};
+
+uint64_t make_cellID(int64_t system, int64_t layer, int64_t module, int64_t x, int64_t y) {
+  uint64_t cellID = 0;
+  cellID = *system_field.set(cellID, system);
+  cellID = *layer_field.set(cellID, layer);
+  cellID = *module_field.set(cellID, module);
+  cellID = *x_field.set(cellID, x);
+  return *y_field.set(cellID, y);
+}
+
+std::vector<uint32_t> masked(const edm4eic::cellid_index& index, uint64_t mask, uint64_t value) {
+  std::vector<uint32_t> hits;
+  uint64_t previous = 0;
+  index.for_each_masked(mask, value, [&](const auto& e) {
+    check(e.cellID >= previous, "masked hits in cellID order");
+    previous = e.cellID;
+    hits.push_back(e.index);
+  });
+  return hits;
+}
+
+void test_index() {
+  std::mt19937_64 rng(1);
+  std::uniform_int_distribution<int> layer(0, 20), module(0, 11), coordinate(-300, 300);
+  std::vector<uint64_t> cellIDs;
+  for (int i = 0; i < 20000; ++i) {
+    cellIDs.push_back(make_cellID(7, layer(rng), module(rng), coordinate(rng), coordinate(rng)));
+  }
+  cellIDs.push_back(cellIDs[5]); // two hits in one cell
+
+  edm4eic::cellid_index index(cellIDs);
+  check(index.size() == cellIDs.size(), "all hits indexed");
+  check(index.find(cellIDs[5]) == 5u, "first hit of a cell");
+  check(index.equal_range(cellIDs[5]).size() == 2 && index.equal_range(cellIDs[5])[1].index == 20000,
+        "all hits of a cell in collection order");
+  check(!index.contains(make_cellID(8, 0, 0, 0, 0)), "missing cell");
+
+  // layer and module queries, before and after adding their masks
+  const uint64_t layer_mask = system_field.mask() | layer_field.mask();
+  const uint64_t module_mask = layer_mask | module_field.mask();
+  for (const bool added : {false, true}) {
+    if (added) {
+      index.add_mask(layer_mask);
+      index.add_mask(module_mask);
+    }
+    for (int l = 0; l <= 21; ++l) {
+      for (const auto& [mask, value] : {std::pair{layer_mask, make_cellID(7, l, 0, 0, 0)},
+                                       std::pair{module_mask, make_cellID(7, l, l % 12, 0, 0)}}) {
+        std::multiset<uint32_t> expected;
+        for (uint32_t i = 0; i < cellIDs.size(); ++i) {
+          if ((cellIDs[i] & mask) == value) {
+            expected.insert(i);
+          }
+        }
+        const auto hits = masked(index, mask, value);
+        check(std::multiset<uint32_t>(hits.begin(), hits.end()) == expected, "masked query");
+      }
+    }
+  }
+
+  // a mask of the most significant bits needs no secondary order
+  const uint64_t top = y_field.mask();
+  const auto value = make_cellID(0, 0, 0, 0, -5);
+  std::size_t expected = 0;
+  for (const auto cellID : cellIDs) {
+    expected += (cellID & top) == value ? 1 : 0;
+  }
+  check(masked(index, top, value).size() == expected, "prefix mask query");
+
+  // neighbors in x and y
+  const auto neighbors = edm4eic::cellid_neighbors::grid({x_field, y_field});
+  check(neighbors.offsets.size() == 8, "eight neighbors on a grid");
+  const auto center = make_cellID(7, 1, 1, -1, 0);
+  const edm4eic::cellid_index small(std::vector<uint64_t>{center, make_cellID(7, 1, 1, 0, 1),
+                                                          make_cellID(7, 1, 1, -2, -1), make_cellID(7, 1, 1, 1, 0)});
+  std::set<uint32_t> found;
+  small.for_each_neighbor(center, neighbors, [&](const auto& e) { found.insert(e.index); });
+  check(found == std::set<uint32_t>{1, 2}, "neighbor hits");
+}
+
+} // namespace
+
+int main() {
+  test_index();
+  std::cout << "cellID index checks passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <edm4eic/CalorimeterHitCollection.h>
+#include <edm4eic/ClusterCollection.h>
+#include <edm4eic/ProtoClusterCollection.h>
+#include <edm4eic/cluster_hits.h>
+
+#include "check.h"
+
+int main() {
+  // four hits, the second shared between two clusters
+  edm4eic::CalorimeterHitCollection hits;
+  hits.setID(5);
+  const std::vector<float> energy{1.0f, 2.0f, 0.5f, 4.0f};
+  const std::vector<float> x{10, 20, 30, 0}, y{0, 0, 0, 40}, z{100, 100, 100, 100};
+  for (std::size_t i = 0; i < energy.size(); ++i) {
+    auto hit = hits.create();
+    hit.setEnergy(energy[i]);
+    hit.setPosition({x[i], y[i], z[i]});
+  }
+
+  // hit contributions in GeV, with the cluster energy as their sum as set by the clustering
+  edm4eic::ClusterCollection clusters;
+  const auto add_cluster = [&](const std::vector<std::size_t>& cluster_hits, const std::vector<float>& contributions,
+                               float cluster_energy) {
+    auto cluster = clusters.create();
+    for (const auto h : cluster_hits) {
+      cluster.addToHits(hits[h]);
+    }
+    for (const auto c : contributions) {
+      cluster.addToHitContributions(c);
+    }
+    cluster.setEnergy(cluster_energy);
+  };
+  add_cluster({0, 1, 2}, {1.0f, 1.2f, 0.5f}, 2.7f);
+  add_cluster({1, 3}, {0.8f, 4.0f}, 4.8f);
+  add_cluster({3}, {}, 4.0f); // without contributions, all of the hit energy
+
+  const auto index = edm4eic::flatten(clusters, hits);
+  check(index.clusters() == 3 && index.offsets == std::vector<uint32_t>{0, 3, 5, 6}, "cluster offsets");
+  check(index.hits == std::vector<uint32_t>{0, 1, 2, 1, 3, 3}, "cluster hits");
+  check_close(index.weights[1], 0.6, 1e-6, "fraction of the shared hit in the first cluster");
+  check_close(index.weights[3], 0.4, 1e-6, "fraction of the shared hit in the second cluster");
+
+  std::vector<float> cluster_energy(3);
+  edm4eic::cluster_energy(index, energy, cluster_energy);
+  for (std::size_t i = 0; i < clusters.size(); ++i) {
+    check_close(cluster_energy[i], clusters[i].getEnergy(), 1e-6, "cluster energy as Cluster::energy");
+  }
+
+  // subdetectors 0 and 1, summing up to the cluster energy
+  const std::vector<uint32_t> subdetector{0, 0, 1, 1};
+  std::vector<float> subdetector_energy(3 * 2);
+  edm4eic::subdetector_energies(index, energy, subdetector, 2, subdetector_energy);
+  check_close(subdetector_energy[0], 2.2, 1e-6, "first subdetector of the first cluster");
+  check_close(subdetector_energy[1], 0.5, 1e-6, "second subdetector of the first cluster");
+  check_close(subdetector_energy[2], 0.8, 1e-6, "first subdetector of the second cluster");
+  check_close(subdetector_energy[3], 4.0, 1e-6, "second subdetector of the second cluster");
+
+  // energy weighted centroid, with the contributed energies as weights
+  const auto shapes = edm4eic::cluster_shape(index, energy, x, y, z);
+  check_close(shapes.x[0], (1.0 * 10 + 1.2 * 20 + 0.5 * 30) / 2.7, 1e-4, "centroid x of the first cluster");
+  check_close(shapes.x[1], 0.8 * 20 / 4.8, 1e-4, "centroid x of the second cluster");
+  check_close(shapes.y[1], 4.0 * 40 / 4.8, 1e-4, "centroid y of the second cluster");
+  check_close(shapes.shape_parameters(2)[0], 0, 1e-6, "radius of a single hit cluster");
+
+  // the same from the columns of the hits, also with log weighting
+  const edm4eic::calorimeter_hit_columns columns{hits};
+  for (const auto type : {edm4eic::centroid_weighting::method::linear, edm4eic::centroid_weighting::method::log}) {
+    const edm4eic::centroid_weighting weighting{type};
+    const auto expected = edm4eic::cluster_shape(index, energy, x, y, z, weighting);
+    const auto from_columns = edm4eic::cluster_shape(index, columns, weighting);
+    check(from_columns.x == expected.x && from_columns.y == expected.y && from_columns.z == expected.z &&
+              from_columns.shape == expected.shape,
+          "cluster shapes from hit columns");
+  }
+
+  // proto clusters carry the fractions themselves
+  edm4eic::ProtoClusterCollection protoclusters;
+  auto protocluster = protoclusters.create();
+  for (const auto& [h, weight] : std::vector<std::pair<std::size_t, float>>{{0, 1.f}, {1, 0.6f}, {2, 1.f}}) {
+    protocluster.addToHits(hits[h]);
+    protocluster.addToWeights(weight);
+  }
+  std::vector<float> protocluster_energy(1);
+  edm4eic::cluster_energy(edm4eic::flatten(protoclusters, hits), energy, protocluster_energy);
+  check_close(protocluster_energy[0], 2.7, 1e-6, "proto cluster energy");
+
+  edm4eic::CalorimeterHitCollection other_hits;
+  other_hits.setID(6);
+  check_throws<std::invalid_argument>([&] { edm4eic::flatten(clusters, other_hits); }, "hits of another collection");
+
+  std::cout << "cluster_hits checks passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <podio/Frame.h>
+#include <podio/ROOTReader.h>
+#include <podio/ROOTWriter.h>
+
+#include <edm4eic/ClusterCollection.h>
+#include <edm4eic/RawTrackerHitCollection.h>
+#include <edm4eic/TensorCollection.h>
+#include <edm4eic/TrackerHitCollection.h>
+#include <edm4eic/collection_pool.h>
+#include <edm4eic/frame_splice.h>
+#include <edm4eic/tensor_utils.h>
+
+#include "check.h"
+
+namespace {
+
+// events of different sizes, so that the collections shrink and grow again
+constexpr std::array<int, 5> sizes{5, 2, 7, 0, 3};
+
+float tensor_value(int event, int i) { return 0.5f * static_cast<float>(i) + static_cast<float>(event); }
+
+} // namespace
+
+int main() {
+  {
+    podio::ROOTWriter writer("test_collection_pool.root");
+    edm4eic::collection_pool pool;
+    edm4eic::collection_arena<edm4eic::TensorCollection, edm4eic::TensorData> tensors{"Tensors"};
+    edm4eic::collection_arena<edm4eic::ClusterCollection, edm4eic::ClusterData> clusters{"Clusters"};
+    const edm4eic::RawTrackerHitCollection* first_raw_hits = nullptr;
+
+    for (int e = 0; e < static_cast<int>(sizes.size()); ++e) {
+      // recycled collections, with relations between them
+      auto& raw_hits = pool.get<edm4eic::RawTrackerHitCollection>("RawTrackerHits");
+      auto& hits = pool.get<edm4eic::TrackerHitCollection>("TrackerHits");
+      first_raw_hits = first_raw_hits ? first_raw_hits : &raw_hits;
+      check(&raw_hits == first_raw_hits && raw_hits.empty() && hits.empty(), "collections recycled empty");
+      for (int i = 0; i < sizes[e]; ++i) {
+        auto raw_hit = raw_hits.create();
+        raw_hit.setCellID(1000 * e + i);
+        raw_hit.setCharge(10 * e + i);
+        auto hit = hits.create();
+        hit.setCellID(1000 * e + i);
+        hit.setPosition({static_cast<float>(e), static_cast<float>(i), 0.f});
+        hit.setRawHit(raw_hit);
+      }
+      pool.frame().putParameter("event", e);
+      writer.writeFrame(pool.frame(), "events");
+      pool.recycle();
+
+      // collections built in their buffers, one tensor and a chain of clusters
+      edm4eic::TensorData tensor{};
+      tensor.elementType = static_cast<int32_t>(edm4eic::tensor_element_type::float32);
+      tensors.push_back(tensor);
+      tensors.add_vector_member<0>(int64_t{sizes[e]});
+      for (int i = 0; i < sizes[e]; ++i) {
+        tensors.add_vector_member<1>(tensor_value(e, i));
+      }
+      for (int i = 0; i < sizes[e]; ++i) {
+        edm4eic::ClusterData cluster{};
+        cluster.energy = static_cast<float>(e + i);
+        clusters.push_back(cluster);
+        const std::vector<float> contributions{static_cast<float>(i), static_cast<float>(i + 1)};
+        clusters.add_vector_member<1>(contributions);
+        if (i > 0) {
+          clusters.add_relation(0, {i - 1, clusters.collectionID()}); // clusters
+        }
+      }
+      edm4eic::frame_buffers buffers;
+      tensors.release(buffers);
+      clusters.release(buffers);
+      writer.writeFrame(podio::Frame(std::make_unique<edm4eic::frame_buffers>(std::move(buffers))), "arena");
+    }
+    writer.finish();
+
+    check(pool.high_water_mark("RawTrackerHits") == 7 && clusters.high_water_mark() == 7, "high-water marks");
+    check(tensors.size() == 0 && clusters.size() == 0, "arenas empty after release");
+  }
+
+  podio::ROOTReader reader;
+  reader.openFile("test_collection_pool.root");
+  check(reader.getEntries("events") == sizes.size() && reader.getEntries("arena") == sizes.size(), "events written");
+  for (int e = 0; e < static_cast<int>(sizes.size()); ++e) {
+    const auto event = podio::Frame(reader.readNextEntry("events"));
+    check(event.getParameter<int>("event") == e, "event parameter");
+    const auto& raw_hits = event.get<edm4eic::RawTrackerHitCollection>("RawTrackerHits");
+    const auto& hits = event.get<edm4eic::TrackerHitCollection>("TrackerHits");
+    check(raw_hits.size() == static_cast<std::size_t>(sizes[e]) && hits.size() == raw_hits.size(),
+          "recycled collection sizes");
+    for (int i = 0; i < sizes[e]; ++i) {
+      check(raw_hits[i].getCellID() == static_cast<uint64_t>(1000 * e + i) && raw_hits[i].getCharge() == 10 * e + i,
+            "recycled raw hit");
+      check(hits[i].getPosition().x == static_cast<float>(e) && hits[i].getPosition().y == static_cast<float>(i),
+            "recycled hit");
+      check(hits[i].getRawHit().getCellID() == hits[i].getCellID(), "relation within a recycled frame");
+    }
+
+    const auto arena = podio::Frame(reader.readNextEntry("arena"));
+    const auto& tensors = arena.get<edm4eic::TensorCollection>("Tensors");
+    check(tensors.size() == 1, "one tensor per event");
+    const auto v = edm4eic::view<float>(tensors[0]);
+    check(v.shape.size() == 1 && v.shape[0] == sizes[e], "tensor shape");
+    for (int i = 0; i < sizes[e]; ++i) {
+      check(v.data[i] == tensor_value(e, i), "tensor value");
+    }
+    const auto& clusters = arena.get<edm4eic::ClusterCollection>("Clusters");
+    check(clusters.size() == static_cast<std::size_t>(sizes[e]), "arena collection size");
+    for (int i = 0; i < sizes[e]; ++i) {
+      const auto cluster = clusters[i];
+      check(cluster.getEnergy() == static_cast<float>(e + i), "arena cluster");
+      const auto contributions = cluster.getHitContributions();
+      check(contributions.size() == 2 && contributions[0] == static_cast<float>(i) &&
+                contributions[1] == static_cast<float>(i + 1),
+            "VectorMember of an arena cluster");
+      check(cluster.getShapeParameters().empty() && cluster.getSubdetectorEnergies().empty(),
+            "empty VectorMembers of an arena cluster");
+      const auto daughters = cluster.getClusters();
+      check(daughters.size() == (i > 0 ? 1u : 0u), "relations of an arena cluster");
+      check(i == 0 || daughters[0].getEnergy() == static_cast<float>(e + i - 1), "relation within an arena collection");
+    }
+  }
+
+  std::cout << "collection_pool checks passed" << std::endl;
+  return 0;
+}
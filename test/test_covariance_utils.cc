@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <array>
+#include <cmath>
+
+#include <edm4eic/covariance_utils.h>
+
+#include "check.h"
+
+namespace {
+
+using vec3 = std::array<double, 3>;
+
+vec3 cross(const vec3& u, const vec3& v) {
+  return {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+}
+
+vec3 direction(double theta, double phi) {
+  return {std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)};
+}
+
+// Global position of bound parameters [l0, l1, theta, phi], relative to the surface center
+vec3 position(const std::array<double, 4>& bound, const edm4eic::bound_surface& surface) {
+  const auto& R = surface.rotation;
+  if (!surface.is_line()) {
+    return {R[0] * bound[0] + R[1] * bound[1], R[3] * bound[0] + R[4] * bound[1], R[6] * bound[0] + R[7] * bound[1]};
+  }
+  const vec3 a{R[2], R[5], R[8]};
+  auto n = cross(a, direction(bound[2], bound[3]));
+  const double norm = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+  return {bound[1] * a[0] + bound[0] * n[0] / norm, bound[1] * a[1] + bound[0] * n[1] / norm,
+          bound[1] * a[2] + bound[0] * n[2] / norm};
+}
+
+// A rotation that is not aligned with any axis
+edm4eic::bound_surface rotated(int type) {
+  const double a = 0.3, b = 1.1;
+  return {type,
+          {std::cos(a), -std::sin(a) * std::cos(b), std::sin(a) * std::sin(b), std::sin(a), std::cos(a) * std::cos(b),
+           -std::cos(a) * std::sin(b), 0, std::sin(b), std::cos(b)}};
+}
+
+void test_kernels() {
+  edm4eic::Cov2f cov;
+  cov.xx = 4;
+  cov.yy = 10;
+  cov.xy = 2;
+
+  // rotation by 90 degrees
+  const auto rotated_cov = edm4eic::similarity<edm4eic::Cov2f>({0, -1, 1, 0}, cov);
+  check_close(rotated_cov.xx, 10, 1e-6, "similarity xx");
+  check_close(rotated_cov.yy, 4, 1e-6, "similarity yy");
+  check_close(rotated_cov.xy, -2, 1e-6, "similarity xy");
+
+  const auto L = edm4eic::cholesky(cov);
+  check(L.has_value(), "cholesky of a positive definite covariance");
+  check_close((*L)[0], 2, 1e-12, "cholesky L00");
+  check_close((*L)[1], 0, 0, "cholesky upper triangle");
+  check_close((*L)[2], 1, 1e-12, "cholesky L10");
+  check_close((*L)[3], 3, 1e-12, "cholesky L11");
+
+  const auto inv = edm4eic::invert(cov);
+  check(inv.has_value(), "inverse of a positive definite covariance");
+  check_close(inv->xx, 10. / 36, 1e-7, "inverse xx");
+  check_close(inv->yy, 4. / 36, 1e-7, "inverse yy");
+  check_close(inv->xy, -2. / 36, 1e-7, "inverse xy");
+
+  check_close(edm4eic::chi2<edm4eic::Cov2f>({1, 1}, cov), 10. / 36, 1e-12, "chi2");
+  check_close(edm4eic::chi2<edm4eic::Cov2f>({2, -1}, cov), (40. + 8 + 4) / 36, 1e-12, "chi2");
+
+  edm4eic::Cov2f singular;
+  singular.xx = 1;
+  singular.yy = 1;
+  singular.xy = 1;
+  check(!edm4eic::cholesky(singular) && !edm4eic::invert(singular), "singular covariance");
+  check(std::isnan(edm4eic::chi2<edm4eic::Cov2f>({1, 1}, singular)), "chi2 of a singular covariance");
+}
+
+void test_cov6f() {
+  // A A^T + 1 is positive definite
+  edm4eic::dense_matrix<6, 6> A, C{};
+  for (std::size_t i = 0; i < 36; ++i) {
+    A[i] = std::sin(1. + 3. * i);
+  }
+  for (std::size_t i = 0; i < 6; ++i) {
+    for (std::size_t j = 0; j < 6; ++j) {
+      for (std::size_t k = 0; k < 6; ++k) {
+        C[i * 6 + j] += A[i * 6 + k] * A[j * 6 + k];
+      }
+      C[i * 6 + j] += i == j ? 1 : 0;
+    }
+  }
+  const auto cov = edm4eic::pack<edm4eic::Cov6f>(C);
+  check_close(cov.covariance[0 + 3 * 4 / 2], C[0 * 6 + 3], 1e-6, "triangular packing of (0, 3)");
+  check_close(cov.covariance[2 + 5 * 6 / 2], C[2 * 6 + 5], 1e-6, "triangular packing of (2, 5)");
+  const auto unpacked = edm4eic::unpack(cov);
+  for (std::size_t i = 0; i < 36; ++i) {
+    check_close(unpacked[i], C[i], 1e-6 * std::fabs(C[i]), "pack and unpack");
+  }
+
+  const auto inv = edm4eic::invert(cov);
+  check(inv.has_value(), "inverse of a Cov6f");
+  const auto Cinv = edm4eic::unpack(*inv);
+  for (std::size_t i = 0; i < 6; ++i) {
+    for (std::size_t j = 0; j < 6; ++j) {
+      double sum = 0;
+      for (std::size_t k = 0; k < 6; ++k) {
+        sum += unpacked[i * 6 + k] * Cinv[k * 6 + j];
+      }
+      check_close(sum, i == j ? 1 : 0, 1e-4, "C C^-1");
+    }
+  }
+}
+
+void test_jacobians() {
+  const float theta = 0.7f, phi = -2.1f, loc0 = 0.35f, loc1 = 12.f, qOverP = -0.4f;
+  for (const int type : {edm4eic::bound_surface::plane, edm4eic::bound_surface::curvilinear,
+                         edm4eic::bound_surface::perigee, edm4eic::bound_surface::straw}) {
+    const auto surface = rotated(type);
+    const auto J = edm4eic::bound_to_free_jacobian(theta, phi, loc0, surface);
+    const auto P = edm4eic::bound_to_position_momentum_jacobian(theta, phi, qOverP, loc0, surface);
+
+    // finite differences in l0, l1, theta and phi
+    const std::array<double, 4> bound{loc0, loc1, theta, phi};
+    const double h = 1e-6;
+    for (std::size_t k = 0; k < 4; ++k) {
+      auto up = bound, down = bound;
+      up[k] += h;
+      down[k] -= h;
+      const auto x_up = position(up, surface), x_down = position(down, surface);
+      const auto d_up = direction(up[2], up[3]), d_down = direction(down[2], down[3]);
+      for (std::size_t i = 0; i < 3; ++i) {
+        const double dx = (x_up[i] - x_down[i]) / (2 * h);
+        const double dd = (d_up[i] - d_down[i]) / (2 * h);
+        check_close(J[i * 6 + k], dx, 1e-6, "d position / d bound of surface type " + std::to_string(type));
+        check_close(J[(4 + i) * 6 + k], dd, 1e-6, "d direction / d bound");
+        check_close(P[i * 6 + k], dx, 1e-6, "d position / d bound in the position-momentum basis");
+        check_close(P[(3 + i) * 6 + k], dd / std::fabs(qOverP), 1e-5, "d momentum / d bound");
+      }
+    }
+    check(J[3 * 6 + 5] == 1 && J[7 * 6 + 4] == 1, "time and q/p carried over");
+
+    // zero momentum without q/p, as in momenta_from_tracking
+    for (const float small : {0.f, 1e-10f, -1e-10f}) {
+      const auto Z = edm4eic::bound_to_position_momentum_jacobian(theta, phi, small, loc0, surface);
+      for (std::size_t k = 0; k < 6; ++k) {
+        for (std::size_t i = 0; i < 3; ++i) {
+          check(Z[i * 6 + k] == P[i * 6 + k], "position rows without momentum");
+          check(Z[(3 + i) * 6 + k] == 0, "zero momentum rows for |q/p| < 1e-9");
+        }
+      }
+    }
+  }
+
+  for (const int type : {edm4eic::bound_surface::cone, edm4eic::bound_surface::cylinder,
+                         edm4eic::bound_surface::disc}) {
+    check_throws<std::invalid_argument>([&] { edm4eic::bound_to_free_jacobian(theta, phi, loc0, rotated(type)); },
+                                        "unsupported surface type " + std::to_string(type));
+  }
+
+  edm4eic::Surface surface;
+  surface.surfaceType = edm4eic::bound_surface::straw;
+  for (std::size_t i = 0; i < 16; ++i) {
+    surface.transform[i] = static_cast<double>(i);
+  }
+  const auto bound = edm4eic::bound_surface::from(surface);
+  check(bound.type == edm4eic::bound_surface::straw && bound.rotation[2] == 2 && bound.rotation[3] == 4 &&
+            bound.rotation[8] == 10,
+        "rotation taken from the affine transform");
+}
+
+} // namespace
+
+int main() {
+  test_kernels();
+  test_cov6f();
+  test_jacobians();
+  std::cout << "covariance utils checks passed" << std::endl;
+  return 0;
+}
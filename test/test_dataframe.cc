@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <Math/Vector4D.h>
+#include <ROOT/RDataFrame.hxx>
+#include <TROOT.h>
+
+#include <podio/Frame.h>
+#include <podio/ROOTReader.h>
+
+#include <edm4eic/ReconstructedParticleCollection.h>
+#include <edm4eic/TrackParametersCollection.h>
+#include <edm4eic/analysis_utils.h>
+#include <edm4eic/dataframe.h>
+#include <edm4eic/vector_utils.h>
+
+#include "check.h"
+
+namespace {
+
+using edm4eic::rdf::RVec;
+
+constexpr double pion_mass = 0.13957;
+
+// deviation relative to the magnitude of the momentum, at least 1 GeV
+double deviation(double value, double expected, double scale) {
+  return std::fabs(value - expected) / std::max(1., scale);
+}
+
+// largest deviation of the track columns of an event from momenta_from_tracking
+double track_deviation(const RVec<edm4eic::TrackParametersData>& tracks, const RVec<float>& p,
+                       const RVec<float>& pt, const RVec<float>& eta,
+                       const RVec<ROOT::Math::PxPyPzMVector>& momenta) {
+  const std::vector<edm4eic::TrackParametersData> data(tracks.begin(), tracks.end());
+  const auto expected = edm4eic::momenta_from_tracking(data, pion_mass);
+  double max = 0;
+  for (std::size_t i = 0; i < tracks.size(); ++i) {
+    const auto& e = expected[i];
+    const double scale = e.P();
+    max = std::max({max, deviation(p[i], e.P(), scale), deviation(pt[i], e.Pt(), scale),
+                    deviation(momenta[i].Px(), e.Px(), scale), deviation(momenta[i].Py(), e.Py(), scale),
+                    deviation(momenta[i].Pz(), e.Pz(), scale)});
+    // without momentum, momenta_from_tracking has no mass either
+    if (e.P() > 0) {
+      max = std::max({max, deviation(eta[i], e.Eta(), 1.), deviation(momenta[i].E(), e.E(), scale)});
+    }
+  }
+  return max;
+}
+
+// largest deviation of the particle columns of an event from vector_utils
+double particle_deviation(const RVec<edm4eic::ReconstructedParticleData>& particles, const RVec<float>& p,
+                          const RVec<float>& pt, const RVec<float>& theta, const RVec<float>& phi,
+                          const RVec<float>& eta, const RVec<float>& rapidity,
+                          const RVec<ROOT::Math::PxPyPzEVector>& momenta) {
+  double max = 0;
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    const auto& m = particles[i].momentum;
+    const double scale = edm4eic::magnitude(m);
+    const ROOT::Math::PxPyPzEVector expected{m.x, m.y, m.z, particles[i].energy};
+    max = std::max({max, deviation(p[i], edm4eic::magnitude(m), scale),
+                    deviation(pt[i], edm4eic::magnitudeTransverse(m), scale),
+                    deviation(theta[i], edm4eic::anglePolar(m), 1.), deviation(phi[i], edm4eic::angleAzimuthal(m), 1.),
+                    deviation(eta[i], edm4eic::eta(m), 1.), deviation(rapidity[i], expected.Rapidity(), 1.),
+                    deviation(momenta[i].E(), particles[i].energy, scale),
+                    deviation(momenta[i].Pz(), m.z, scale)});
+  }
+  return max;
+}
+
+} // namespace
+
+int main() {
+  // the columns of the file written by write_events, computed on the worker threads
+  ROOT::EnableImplicitMT(4);
+  ROOT::RDataFrame df("events", "edm4eic_events.root");
+  const auto track_momenta = [](const RVec<edm4eic::TrackParametersData>& tracks) {
+    return edm4eic::rdf::track_momenta(tracks, pion_mass);
+  };
+  auto columns = df.Define("track_p", edm4eic::rdf::track_p, {"TrackParameters"})
+                     .Define("track_pt", edm4eic::rdf::track_pt, {"TrackParameters"})
+                     .Define("track_eta", edm4eic::rdf::track_eta, {"TrackParameters"})
+                     .Define("track_momenta", track_momenta, {"TrackParameters"})
+                     .Define("track_deviation", track_deviation,
+                             {"TrackParameters", "track_p", "track_pt", "track_eta", "track_momenta"})
+                     .Define("p", edm4eic::rdf::p, {"ReconstructedParticles"})
+                     .Define("pt", edm4eic::rdf::pt, {"ReconstructedParticles"})
+                     .Define("theta", edm4eic::rdf::theta, {"ReconstructedParticles"})
+                     .Define("phi", edm4eic::rdf::phi, {"ReconstructedParticles"})
+                     .Define("eta", edm4eic::rdf::eta, {"ReconstructedParticles"})
+                     .Define("rapidity", edm4eic::rdf::rapidity, {"ReconstructedParticles"})
+                     .Define("momenta", edm4eic::rdf::momenta, {"ReconstructedParticles"})
+                     .Define("particle_deviation", particle_deviation,
+                             {"ReconstructedParticles", "p", "pt", "theta", "phi", "eta", "rapidity", "momenta"});
+  auto events = columns.Count();
+  auto track_p_sum = columns.Sum<RVec<float>>("track_p");
+  auto max_track_deviation = columns.Max<double>("track_deviation");
+  auto max_particle_deviation = columns.Max<double>("particle_deviation");
+
+  check_close(*max_track_deviation, 0, 1e-6, "track columns against momenta_from_tracking");
+  check_close(*max_particle_deviation, 0, 1e-6, "particle columns against vector_utils");
+
+  // the same events read through podio
+  podio::ROOTReader reader;
+  reader.openFile("edm4eic_events.root");
+  check(*events == reader.getEntries("events"), "all events processed");
+  double expected_p_sum = 0;
+  for (unsigned i = 0; i < reader.getEntries("events"); ++i) {
+    const auto event = podio::Frame(reader.readNextEntry("events"));
+    const auto& tracks = event.get<edm4eic::TrackParametersCollection>("TrackParameters");
+    std::vector<double> px(tracks.size()), py(tracks.size()), pz(tracks.size()), energy(tracks.size());
+    edm4eic::momenta_from_tracking(tracks, pion_mass, px, py, pz, energy);
+    for (std::size_t k = 0; k < tracks.size(); ++k) {
+      expected_p_sum += std::sqrt(px[k] * px[k] + py[k] * py[k] + pz[k] * pz[k]);
+    }
+  }
+  check(expected_p_sum > 0, "tracks with momentum");
+  check_close(*track_p_sum, expected_p_sum, 1e-5 * expected_p_sum, "track momenta summed over the events");
+
+  std::cout << "dataframe checks passed" << std::endl;
+  return 0;
+}
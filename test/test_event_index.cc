@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <edm4eic/event_index.h>
+
+#include "check.h"
+
+int main() {
+  // six entries, without kinematics in entries 1 and 4
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const std::vector<float> Q2{5.f, nan, 120.f, 40.f, nan, 1000.f};
+  const std::vector<uint32_t> tracks{0, 2, 3, 1, 5, 4};
+  {
+    edm4eic::event_index_builder builder(Q2.size());
+    auto q2 = builder.add_float("InclusiveKinematicsElectron.Q2");
+    check(q2.size() == Q2.size() && std::isnan(q2[1]), "float column initialized to NaN");
+    auto size = builder.add_count("CentralCKFTracks.size");
+    check(size.size() == tracks.size() && size[4] == 0, "count column initialized to 0");
+    for (std::size_t i = 0; i < Q2.size(); ++i) {
+      if (!std::isnan(Q2[i])) {
+        q2[i] = Q2[i];
+      }
+      size[i] = tracks[i];
+    }
+    check_throws<std::invalid_argument>([&] { builder.add_count(""); }, "empty column name");
+    check_throws<std::invalid_argument>([&] { builder.add_float(std::string(64, 'x')); }, "column name too long");
+    builder.write("test_event_index.idx");
+  }
+
+  const edm4eic::event_index index("test_event_index.idx");
+  check(index.entries() == Q2.size(), "entries");
+  check(index.columns() == std::vector<std::string>{"InclusiveKinematicsElectron.Q2", "CentralCKFTracks.size"},
+        "column names");
+  const auto q2 = index.floats("InclusiveKinematicsElectron.Q2");
+  for (std::size_t i = 0; i < Q2.size(); ++i) {
+    check(std::isnan(Q2[i]) ? std::isnan(q2[i]) : q2[i] == Q2[i], "float column read back");
+  }
+  const auto size = index.counts("CentralCKFTracks.size");
+  check(std::vector<uint32_t>(size.begin(), size.end()) == tracks, "count column read back");
+
+  // inclusive ranges, open ends and NaN entries that never pass
+  using range = edm4eic::event_index::range;
+  check(index.select({}) == std::vector<std::size_t>{0, 1, 2, 3, 4, 5}, "no ranges");
+  check(index.select({range{"InclusiveKinematicsElectron.Q2", 40, 1000}}) == std::vector<std::size_t>{2, 3, 5},
+        "inclusive float range");
+  check(index.select({range{"InclusiveKinematicsElectron.Q2"}}) == std::vector<std::size_t>{0, 2, 3, 5},
+        "open range without the NaN entries");
+  check(index.select({range{"CentralCKFTracks.size", 2}}) == std::vector<std::size_t>{1, 2, 4, 5}, "count range");
+  check(index.select({range{"InclusiveKinematicsElectron.Q2", 10}, range{"CentralCKFTracks.size", 0, 3}}) ==
+            std::vector<std::size_t>{2, 3},
+        "all ranges have to pass");
+  check(index.select({range{"CentralCKFTracks.size", 6}}).empty(), "no entry passes");
+
+  check_throws<std::out_of_range>([&] { index.select({range{"InclusiveKinematicsJB.Q2"}}); }, "unknown column");
+  check_throws<std::invalid_argument>([&] { index.counts("InclusiveKinematicsElectron.Q2"); },
+                                      "column of another type");
+  check_throws<std::runtime_error>([] { edm4eic::event_index("test_event_index.missing"); }, "missing file");
+  {
+    std::ofstream other{"test_event_index.txt"};
+    other << "not an event index, but long enough for its header\n";
+  }
+  check_throws<std::runtime_error>([] { edm4eic::event_index("test_event_index.txt"); }, "file of another format");
+
+  std::cout << "event_index checks passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <edm4hep/MCParticleCollection.h>
+#include <edm4hep/SimTrackerHitCollection.h>
+
+#include <edm4eic/bunch_timeline.h>
+#include <edm4eic/frame_splice.h>
+
+#include "check.h"
+
+namespace {
+
+template <typename CollT> podio::CollectionReadBuffers make_buffers() {
+  auto buffers = podio::CollectionBufferFactory::instance().createBuffers(std::string(CollT::typeName),
+                                                                          CollT::schemaVersion, false);
+  check(buffers.has_value(), "buffers for " + std::string(CollT::typeName));
+  return *buffers;
+}
+
+template <typename DataT> std::vector<DataT>& data(podio::CollectionReadBuffers* buffers) {
+  return *static_cast<std::vector<DataT>*>(buffers->data);
+}
+
+std::vector<podio::ObjectID>& refs(podio::CollectionReadBuffers* buffers, std::size_t k) {
+  return *(*buffers->references)[k];
+}
+
+bool same(const podio::ObjectID& a, const podio::ObjectID& b) {
+  return a.index == b.index && a.collectionID == b.collectionID;
+}
+
+// Two particles, the second a daughter of the first, and hits pointing at them
+edm4eic::frame_buffers make_frame(uint32_t particles_id, uint32_t hits_id, float time,
+                                  const std::vector<podio::ObjectID>& hit_particles) {
+  edm4eic::frame_buffers frame;
+  auto particles = make_buffers<edm4hep::MCParticleCollection>();
+  auto& particle_data = data<edm4hep::MCParticleData>(&particles);
+  particle_data.resize(2);
+  particle_data[0].time = time;
+  particle_data[0].daughters_end = 1;
+  particle_data[1].time = time + 1;
+  particle_data[1].parents_end = 1;
+  particle_data[1].daughters_begin = 1;
+  particle_data[1].daughters_end = 1;
+  refs(&particles, 0).push_back({0, particles_id}); // parents
+  refs(&particles, 1).push_back({1, particles_id}); // daughters
+  frame.put("MCParticles", particles_id, particles);
+
+  auto hits = make_buffers<edm4hep::SimTrackerHitCollection>();
+  for (std::size_t i = 0; i < hit_particles.size(); ++i) {
+    data<edm4hep::SimTrackerHitData>(&hits).emplace_back().time = time + 10 + i;
+    refs(&hits, 0).push_back(hit_particles[i]);
+  }
+  frame.put("SimTrackerHits", hits_id, hits);
+  return frame;
+}
+
+void test_splice() {
+  auto dst = make_frame(11, 12, 1, {{0, 11}});
+  const auto src = make_frame(21, 22, 3, {{1, 21}, {0, 99}});
+
+  const auto dropped = edm4eic::splice(dst, src, {100, 0});
+  check(dropped == 1, "relation into a collection that is not spliced is dropped");
+
+  auto* particles = dst.buffers("MCParticles");
+  const auto& particle_data = data<edm4hep::MCParticleData>(particles);
+  check(particle_data.size() == 4, "particles appended");
+  check_close(particle_data[0].time, 1, 0, "signal particle time kept");
+  check_close(particle_data[2].time, 103, 0, "background particle time shifted");
+  check_close(particle_data[3].time, 104, 0, "background particle time shifted");
+  check(particle_data[2].daughters_begin == 1 && particle_data[2].daughters_end == 2, "daughter range shifted");
+  check(particle_data[3].parents_begin == 1 && particle_data[3].parents_end == 2, "parent range shifted");
+  check(refs(particles, 0).size() == 2 && same(refs(particles, 0)[1], {2, 11}), "parent remapped");
+  check(refs(particles, 1).size() == 2 && same(refs(particles, 1)[1], {3, 11}), "daughter remapped");
+
+  auto* hits = dst.buffers("SimTrackerHits");
+  const auto& hit_data = data<edm4hep::SimTrackerHitData>(hits);
+  check(hit_data.size() == 3, "hits appended");
+  check_close(hit_data[0].time, 11, 0, "signal hit time kept");
+  check_close(hit_data[1].time, 113, 0, "background hit time shifted");
+  check(same(refs(hits, 0)[0], {0, 11}), "signal hit relation kept");
+  check(same(refs(hits, 0)[1], {3, 11}), "background hit relation remapped");
+  check(refs(hits, 0)[2].index == podio::ObjectID::invalid, "unresolvable relation invalidated");
+
+  edm4eic::shift_times(dst, {-100, 0});
+  check_close(data<edm4hep::SimTrackerHitData>(hits)[1].time, 13, 0, "times shifted back");
+}
+
+void test_schema_version() {
+  auto dst = make_frame(11, 12, 1, {});
+  auto src = make_frame(21, 22, 3, {});
+  src.buffers("MCParticles")->schemaVersion = edm4hep::MCParticleCollection::schemaVersion - 1;
+  check_throws<std::runtime_error>([&] { edm4eic::splice(dst, src); }, "splicing an older schema version");
+  check(data<edm4hep::MCParticleData>(dst.buffers("MCParticles")).size() == 2, "nothing spliced on error");
+}
+
+void test_timeline() {
+  const double spacing = 10;
+  edm4eic::bunch_timeline timeline(1e6, spacing, 42); // 1 MHz, one event per 1000 ns on average
+  const auto first = timeline.arrivals(0, 1e6);
+  const auto second = timeline.arrivals(1e6, 2e6);
+  for (const auto* times : {&first, &second}) {
+    check(std::is_sorted(times->begin(), times->end()), "arrivals in order");
+    for (const auto t : *times) {
+      check_close(t, std::round(t / spacing) * spacing, 1e-9, "arrival on a bunch crossing");
+    }
+  }
+  check(!first.empty() && first.back() < 1e6 && !second.empty() && second.front() >= 1e6, "arrivals in the windows");
+  check_close(first.size() + second.size(), 2000, 250, "number of arrivals");
+}
+
+} // namespace
+
+int main() {
+  test_splice();
+  test_schema_version();
+  test_timeline();
+  std::cout << "frame splicing checks passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include <podio/Frame.h>
+
+#include <edm4eic/CalorimeterHitCollection.h>
+#include <edm4eic/PMTHitCollection.h>
+#include <edm4eic/TrackerHitCollection.h>
+#include <edm4eic/hit_columns.h>
+
+#include "check.h"
+
+namespace {
+
+constexpr std::size_t hit_count = 5;
+
+// A column against the getter of every hit; the second access returns the cached column
+template <typename ColumnF, typename GetterF, typename CollT>
+void check_column(const CollT& hits, ColumnF column, GetterF getter, const std::string& what) {
+  const auto values = column();
+  check(values.size() == hits.size(), what + ": size");
+  for (std::size_t i = 0; i < hits.size(); ++i) {
+    check(values[i] == getter(hits[i]), what + ": value of hit " + std::to_string(i));
+  }
+  const auto again = column();
+  check(again.data() == values.data() && again.size() == values.size(), what + ": cached");
+}
+
+edm4eic::CalorimeterHitCollection make_calorimeter_hits() {
+  edm4eic::CalorimeterHitCollection hits;
+  for (std::size_t i = 0; i < hit_count; ++i) {
+    const auto f = static_cast<float>(i);
+    auto hit = hits.create();
+    hit.setCellID((uint64_t{1} << 40) + i);
+    hit.setEnergy(1 + f);
+    hit.setEnergyError(0.1f * f);
+    hit.setTime(10 + f);
+    hit.setTimeError(0.5f + f);
+    hit.setPosition({f, 2 * f, 3 * f});
+    hit.setDimension({1 + f, 2 + f, 3 + f});
+    hit.setSector(static_cast<int32_t>(i));
+    hit.setLayer(10 - static_cast<int32_t>(i));
+    hit.setLocal({-f, -2 * f, -3 * f});
+  }
+  return hits;
+}
+
+edm4eic::TrackerHitCollection make_tracker_hits() {
+  edm4eic::TrackerHitCollection hits;
+  for (std::size_t i = 0; i < hit_count; ++i) {
+    const auto f = static_cast<float>(i);
+    auto hit = hits.create();
+    hit.setCellID((uint64_t{1} << 50) + i);
+    hit.setPosition({4 * f, 5 * f, 6 * f});
+    hit.setPositionError({0.01f * f, 0.02f * f, 0.03f * f});
+    hit.setTime(20 + f);
+    hit.setTimeError(0.25f + f);
+    hit.setEdep(1e-6f * (1 + f));
+    hit.setEdepError(1e-7f * f);
+  }
+  return hits;
+}
+
+edm4eic::PMTHitCollection make_pmt_hits() {
+  edm4eic::PMTHitCollection hits;
+  for (std::size_t i = 0; i < hit_count; ++i) {
+    const auto f = static_cast<float>(i);
+    auto hit = hits.create();
+    hit.setCellID((uint64_t{1} << 60) + i);
+    hit.setNpe(2 + f);
+    hit.setTime(30 + f);
+    hit.setTimeError(0.75f + f);
+    hit.setPosition({7 * f, 8 * f, 9 * f});
+    hit.setDimension({3 + f, 2 + f, 1 + f});
+    hit.setSector(static_cast<int32_t>(2 * i));
+    hit.setLocal({-4 * f, -5 * f, -6 * f});
+  }
+  return hits;
+}
+
+void test_calorimeter_hits(const edm4eic::CalorimeterHitCollection& hits) {
+  const edm4eic::calorimeter_hit_columns columns{hits};
+  check(columns.size() == hits.size() && &columns.collection() == &hits, "calorimeter hit view");
+  check_column(hits, [&] { return columns.cellID(); }, [](const auto& h) { return h.getCellID(); }, "cellID");
+  check_column(hits, [&] { return columns.energy(); }, [](const auto& h) { return h.getEnergy(); }, "energy");
+  check_column(hits, [&] { return columns.energyError(); }, [](const auto& h) { return h.getEnergyError(); },
+               "energyError");
+  check_column(hits, [&] { return columns.time(); }, [](const auto& h) { return h.getTime(); }, "time");
+  check_column(hits, [&] { return columns.timeError(); }, [](const auto& h) { return h.getTimeError(); },
+               "timeError");
+  check_column(hits, [&] { return columns.position_x(); }, [](const auto& h) { return h.getPosition().x; },
+               "position x");
+  check_column(hits, [&] { return columns.position_y(); }, [](const auto& h) { return h.getPosition().y; },
+               "position y");
+  check_column(hits, [&] { return columns.position_z(); }, [](const auto& h) { return h.getPosition().z; },
+               "position z");
+  check_column(hits, [&] { return columns.dimension_x(); }, [](const auto& h) { return h.getDimension().x; },
+               "dimension x");
+  check_column(hits, [&] { return columns.dimension_y(); }, [](const auto& h) { return h.getDimension().y; },
+               "dimension y");
+  check_column(hits, [&] { return columns.dimension_z(); }, [](const auto& h) { return h.getDimension().z; },
+               "dimension z");
+  check_column(hits, [&] { return columns.sector(); }, [](const auto& h) { return h.getSector(); }, "sector");
+  check_column(hits, [&] { return columns.layer(); }, [](const auto& h) { return h.getLayer(); }, "layer");
+  check_column(hits, [&] { return columns.local_x(); }, [](const auto& h) { return h.getLocal().x; }, "local x");
+  check_column(hits, [&] { return columns.local_y(); }, [](const auto& h) { return h.getLocal().y; }, "local y");
+  check_column(hits, [&] { return columns.local_z(); }, [](const auto& h) { return h.getLocal().z; }, "local z");
+}
+
+void test_tracker_hits(const edm4eic::TrackerHitCollection& hits) {
+  const edm4eic::tracker_hit_columns columns{hits};
+  check(columns.size() == hits.size() && &columns.collection() == &hits, "tracker hit view");
+  check_column(hits, [&] { return columns.cellID(); }, [](const auto& h) { return h.getCellID(); }, "cellID");
+  check_column(hits, [&] { return columns.position_x(); }, [](const auto& h) { return h.getPosition().x; },
+               "position x");
+  check_column(hits, [&] { return columns.position_y(); }, [](const auto& h) { return h.getPosition().y; },
+               "position y");
+  check_column(hits, [&] { return columns.position_z(); }, [](const auto& h) { return h.getPosition().z; },
+               "position z");
+  check_column(hits, [&] { return columns.positionError_xx(); },
+               [](const auto& h) { return h.getPositionError().xx; }, "position error xx");
+  check_column(hits, [&] { return columns.positionError_yy(); },
+               [](const auto& h) { return h.getPositionError().yy; }, "position error yy");
+  check_column(hits, [&] { return columns.positionError_zz(); },
+               [](const auto& h) { return h.getPositionError().zz; }, "position error zz");
+  check_column(hits, [&] { return columns.time(); }, [](const auto& h) { return h.getTime(); }, "time");
+  check_column(hits, [&] { return columns.timeError(); }, [](const auto& h) { return h.getTimeError(); },
+               "timeError");
+  check_column(hits, [&] { return columns.edep(); }, [](const auto& h) { return h.getEdep(); }, "edep");
+  check_column(hits, [&] { return columns.edepError(); }, [](const auto& h) { return h.getEdepError(); },
+               "edepError");
+}
+
+void test_pmt_hits(const edm4eic::PMTHitCollection& hits) {
+  const edm4eic::pmt_hit_columns columns{hits};
+  check(columns.size() == hits.size() && &columns.collection() == &hits, "PMT hit view");
+  check_column(hits, [&] { return columns.cellID(); }, [](const auto& h) { return h.getCellID(); }, "cellID");
+  check_column(hits, [&] { return columns.npe(); }, [](const auto& h) { return h.getNpe(); }, "npe");
+  check_column(hits, [&] { return columns.time(); }, [](const auto& h) { return h.getTime(); }, "time");
+  check_column(hits, [&] { return columns.timeError(); }, [](const auto& h) { return h.getTimeError(); },
+               "timeError");
+  check_column(hits, [&] { return columns.position_x(); }, [](const auto& h) { return h.getPosition().x; },
+               "position x");
+  check_column(hits, [&] { return columns.position_y(); }, [](const auto& h) { return h.getPosition().y; },
+               "position y");
+  check_column(hits, [&] { return columns.position_z(); }, [](const auto& h) { return h.getPosition().z; },
+               "position z");
+  check_column(hits, [&] { return columns.dimension_x(); }, [](const auto& h) { return h.getDimension().x; },
+               "dimension x");
+  check_column(hits, [&] { return columns.dimension_y(); }, [](const auto& h) { return h.getDimension().y; },
+               "dimension y");
+  check_column(hits, [&] { return columns.dimension_z(); }, [](const auto& h) { return h.getDimension().z; },
+               "dimension z");
+  check_column(hits, [&] { return columns.sector(); }, [](const auto& h) { return h.getSector(); }, "sector");
+  check_column(hits, [&] { return columns.local_x(); }, [](const auto& h) { return h.getLocal().x; }, "local x");
+  check_column(hits, [&] { return columns.local_y(); }, [](const auto& h) { return h.getLocal().y; }, "local y");
+  check_column(hits, [&] { return columns.local_z(); }, [](const auto& h) { return h.getLocal().z; }, "local z");
+}
+
+void test_column_cache() {
+  podio::Frame frame;
+  const auto& ecal_hits = frame.put(make_calorimeter_hits(), "EcalBarrelRecHits");
+  const auto& hcal_hits = frame.put(make_calorimeter_hits(), "HcalBarrelRecHits");
+  const auto& tracker_hits = frame.put(make_tracker_hits(), "SiBarrelHits");
+
+  // one view per collection name and view type, sharing its filled columns
+  edm4eic::column_cache columns{frame};
+  const auto& ecal = columns.get<edm4eic::calorimeter_hit_columns>("EcalBarrelRecHits");
+  check(&ecal.collection() == &ecal_hits, "view of the frame collection");
+  const auto energy = ecal.energy();
+  const auto& ecal_again = columns.get<edm4eic::calorimeter_hit_columns>("EcalBarrelRecHits");
+  check(&ecal_again == &ecal && ecal_again.energy().data() == energy.data(), "view cached by name");
+  const auto& hcal = columns.get<edm4eic::calorimeter_hit_columns>("HcalBarrelRecHits");
+  check(&hcal != &ecal && &hcal.collection() == &hcal_hits, "view of another collection");
+  const auto& tracker = columns.get<edm4eic::tracker_hit_columns>("SiBarrelHits");
+  check(&tracker.collection() == &tracker_hits && tracker.time().size() == hit_count, "view of another type");
+
+  columns.clear();
+  const auto& refilled = columns.get<edm4eic::calorimeter_hit_columns>("EcalBarrelRecHits");
+  check(&refilled.collection() == &ecal_hits && refilled.energy().size() == hit_count &&
+            refilled.energy()[2] == ecal_hits[2].getEnergy(),
+        "view recreated after clear");
+}
+
+} // namespace
+
+int main() {
+  test_calorimeter_hits(make_calorimeter_hits());
+  test_tracker_hits(make_tracker_hits());
+  test_pmt_hits(make_pmt_hits());
+  test_column_cache();
+
+  std::cout << "hit_columns checks passed" << std::endl;
+  return 0;
+}
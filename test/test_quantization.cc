@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <podio/Frame.h>
+#include <podio/ROOTReader.h>
+#include <podio/ROOTWriter.h>
+
+#include <edm4hep/SimCalorimeterHitCollection.h>
+
+#include <edm4eic/RawCALOROCHitCollection.h>
+#include <edm4eic/TrackParametersCollection.h>
+#include <edm4eic/quantization.h>
+
+#include "check.h"
+
+namespace {
+
+// Error of quantized values within the range against the documented bound
+void check_bound(const edm4eic::quantizer& q, double min, double max, bool relative) {
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> uniform{min, max};
+  const std::string what = q.to_string();
+  for (int i = 0; i < 10000; ++i) {
+    const double value = relative ? std::copysign(min * std::pow(max / min, (uniform(rng) - min) / (max - min)),
+                                                  i % 2 ? 1. : -1.)
+                                  : uniform(rng);
+    const double quantized = q(value);
+    const double bound = q.error_bound() * (relative ? std::fabs(value) : 1);
+    check_close(quantized, value, bound, what + " of " + std::to_string(value));
+    check(q(quantized) == quantized, what + " is idempotent");
+    const float value_f = static_cast<float>(value);
+    check_close(q(value_f), value_f, q.error_bound() * (relative ? std::fabs(value_f) : 1), what + " of a float");
+  }
+  check(std::isnan(q(std::numeric_limits<double>::quiet_NaN())), what + " keeps NaN");
+  check(q(std::numeric_limits<float>::infinity()) == std::numeric_limits<float>::infinity(), what + " keeps inf");
+  check(edm4eic::quantizer::from_string(what).to_string() == what, what + " round trip of the specification");
+}
+
+// Distinct covariance elements of a track parameter, growing with scale
+edm4eic::Cov6f covariance(float scale) {
+  std::array<float, 21> elements{};
+  for (std::size_t i = 0; i < elements.size(); ++i) {
+    elements[i] = scale * static_cast<float>(i + 1) / 7.f;
+  }
+  return edm4eic::Cov6f{elements};
+}
+
+} // namespace
+
+int main() {
+  // error bounds of each method
+  check_bound(edm4eic::quantizer::mantissa(10), 1e-3, 1e3, true);
+  check_bound(edm4eic::quantizer::linear(16, -4096, 4096), -4096, 4096, false);
+  check_bound(edm4eic::quantizer::log(12, 1e-6, 1e3), 1e-6, 1e3, true);
+  check(edm4eic::quantizer::linear(8, 0, 1)(2.) == 1., "linear clamps to the range");
+  check(edm4eic::quantizer::log(12, 1e-6, 1e3)(1e-9) == 0., "log zeroes magnitudes below the range");
+  check_throws<std::invalid_argument>([] { edm4eic::quantizer::from_string("linear:16:1"); }, "missing field");
+
+  const auto q = edm4eic::quantization::from_string(
+      "time=linear:16:-1000:1000,energy=log:12:1e-6:1e3,covariance=mantissa:8,adc=linear:8:0:1024,tdc=linear:4:0:1024");
+  check(edm4eic::quantization::from_string(q.to_string()).to_string() == q.to_string(),
+        "round trip of the collection specification");
+  check(q.position.type() == edm4eic::quantizer::method::none, "groups not given are not quantized");
+
+  // the samples of digitized hits and the covariance of track parameters
+  edm4eic::TrackParametersCollection tracks;
+  for (int i = 0; i < 10; ++i) {
+    auto track = tracks.create();
+    track.setTime(0.1f * static_cast<float>(i) + 0.01f);
+    track.setQOverP(0.3f + 0.01f * static_cast<float>(i));
+    track.setCovariance(covariance(1.f + static_cast<float>(i)));
+  }
+  edm4eic::RawCALOROCHitCollection calo_hits;
+  for (int i = 0; i < 5; ++i) {
+    auto hit = calo_hits.create();
+    hit.setCellID(i);
+    for (uint16_t s = 0; s < 4; ++s) {
+      hit.addToASamples({static_cast<uint16_t>(100 * i + 7 * s), static_cast<uint16_t>(33 * s), 0});
+      hit.addToBSamples({static_cast<uint16_t>(2000 + s), static_cast<uint16_t>(65535 - s), 1});
+    }
+  }
+  edm4hep::SimCalorimeterHitCollection unquantized;
+  unquantized.create().setEnergy(0.123456f);
+
+  // quantize the frame right before writing, and read it back
+  {
+    podio::Frame frame;
+    frame.put(std::move(tracks), "TrackParameters");
+    frame.put(std::move(calo_hits), "RawCALOROCHits");
+    frame.put(std::move(unquantized), "SimCalorimeterHits");
+    check(edm4eic::quantize(frame, "TrackParameters", q), "track parameters are quantized");
+    check(edm4eic::quantize(frame, "RawCALOROCHits", q), "digitized hits are quantized");
+    check(!edm4eic::quantize(frame, "Missing", q), "missing collections are not quantized");
+
+    const auto& written = frame.get<edm4eic::TrackParametersCollection>("TrackParameters");
+    check(written[1].getCovariance().covariance[1] == covariance(2.f).covariance[1], "objects keep their values");
+
+    podio::ROOTWriter writer("test_quantization.root");
+    writer.writeFrame(frame, "events");
+    writer.finish();
+  }
+
+  podio::ROOTReader reader;
+  reader.openFile("test_quantization.root");
+  const auto frame = podio::Frame(reader.readNextEntry("events"));
+  check(frame.getParameter<std::string>(edm4eic::quantization_parameter("TrackParameters")) == q.to_string(),
+        "recorded quantization");
+  check(!frame.getParameter<std::string>(edm4eic::quantization_parameter("SimCalorimeterHits")).has_value(),
+        "no quantization recorded for other collections");
+
+  const auto& tracks_read = frame.get<edm4eic::TrackParametersCollection>("TrackParameters");
+  check(tracks_read.size() == 10, "track parameters read back");
+  for (std::size_t i = 0; i < tracks_read.size(); ++i) {
+    const auto track = tracks_read[i];
+    const float time = 0.1f * static_cast<float>(i) + 0.01f;
+    check(track.getTime() == q.time(time), "time quantized");
+    check_close(track.getTime(), time, q.time.error_bound(), "time within the bound");
+    check(track.getQOverP() == 0.3f + 0.01f * static_cast<float>(i), "track parameters themselves unchanged");
+    const auto expected = covariance(1.f + static_cast<float>(i));
+    for (std::size_t k = 0; k < expected.covariance.size(); ++k) {
+      const float element = expected.covariance[k];
+      check(track.getCovariance().covariance[k] == q.covariance(element), "covariance quantized");
+      check_close(track.getCovariance().covariance[k], element, q.covariance.error_bound() * element,
+                  "covariance within the bound");
+    }
+  }
+
+  const auto& calo_hits_read = frame.get<edm4eic::RawCALOROCHitCollection>("RawCALOROCHits");
+  check(calo_hits_read.size() == 5, "digitized hits read back");
+  for (std::size_t i = 0; i < calo_hits_read.size(); ++i) {
+    const auto a_samples = calo_hits_read[i].getASamples();
+    const auto b_samples = calo_hits_read[i].getBSamples();
+    check(a_samples.size() == 4 && b_samples.size() == 4, "samples read back");
+    for (uint16_t s = 0; s < 4; ++s) {
+      const auto adc = static_cast<uint16_t>(100 * i + 7 * s);
+      check(a_samples[s].ADC == static_cast<uint16_t>(std::nearbyint(q.adc(double(adc)))), "ADC quantized");
+      check_close(a_samples[s].ADC, adc, q.adc.error_bound(), "ADC within the bound");
+      check_close(a_samples[s].timeOfArrival, 33 * s, q.tdc.error_bound(), "TOA within the bound");
+      check(a_samples[s].timeOfArrival % 64 == 0, "TOA on the grid");
+      check(b_samples[s].lowGainADC == 1024, "ADC clamped to the range");
+      check(b_samples[s].highGainADC == 1024, "ADC clamped to the range");
+      check(a_samples[s].timeOverThreshold == 0 && b_samples[s].timeOfArrival == 0, "TDC counts rounded");
+    }
+  }
+
+  check(frame.get<edm4hep::SimCalorimeterHitCollection>("SimCalorimeterHits")[0].getEnergy() == 0.123456f,
+        "other collections unchanged");
+
+  std::cout << "quantization checks passed" << std::endl;
+  return 0;
+}
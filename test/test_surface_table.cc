@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <podio/Frame.h>
+#include <podio/GenericParameters.h>
+#include <podio/ROOTReader.h>
+#include <podio/ROOTWriter.h>
+
+#include <edm4eic/Surface.h>
+#include <edm4eic/surface_table.h>
+
+#include "check.h"
+
+namespace {
+
+edm4eic::Surface make_surface(uint64_t geometryId, uint64_t identifier, int surfaceType) {
+  edm4eic::Surface surface;
+  surface.surfaceType = surfaceType;
+  surface.boundsType = 6;
+  surface.geometryId = geometryId;
+  surface.identifier = identifier;
+  surface.boundValuesSize = 5;
+  for (std::size_t k = 0; k < surface.boundValues.size(); ++k) {
+    surface.boundValues[k] = static_cast<double>(geometryId % 1000) + 0.5 * static_cast<double>(k);
+  }
+  for (std::size_t k = 0; k < surface.transform.size(); ++k) {
+    surface.transform[k] = static_cast<double>(surfaceType) - 0.25 * static_cast<double>(k);
+  }
+  return surface;
+}
+
+bool same_surface(const edm4eic::Surface& a, const edm4eic::Surface& b) {
+  return a.surfaceType == b.surfaceType && a.boundsType == b.boundsType && a.geometryId == b.geometryId &&
+         a.identifier == b.identifier && a.boundValuesSize == b.boundValuesSize && a.boundValues == b.boundValues &&
+         a.transform == b.transform;
+}
+
+// the same surfaces at the same indices, found by their geometry IDs
+void check_same_table(const edm4eic::surface_table& read, const edm4eic::surface_table& table,
+                      const std::string& what) {
+  check(read.size() == table.size(), what + ": size");
+  for (uint32_t i = 0; i < table.size(); ++i) {
+    check(same_surface(read[i], table[i]), what + ": surface by index");
+    const auto* found = read.find(table[i].geometryId);
+    check(found == &read[i], what + ": surface by geometry ID");
+    check(read.index(table[i].geometryId) == i, what + ": index by geometry ID");
+  }
+}
+
+} // namespace
+
+int main() {
+  // IDs with the high bit of either 32-bit half set, which are negative in
+  // the int parameter columns
+  const std::vector<edm4eic::Surface> surfaces{
+      make_surface(0x8000000000000001, 0xFFFFFFFF80000000, 4),
+      make_surface(0x00000001FFFFFFFF, 0x7FFFFFFF00000001, 1),
+      make_surface(0x0123456789ABCDEF, 0, 2),
+      make_surface(0xFFFFFFFFFFFFFFFF, 0x8000000080000000, 5),
+  };
+
+  edm4eic::surface_table table;
+  check(table.empty(), "empty table");
+  for (uint32_t i = 0; i < surfaces.size(); ++i) {
+    check(table.intern(surfaces[i]) == i, "new surfaces appended");
+  }
+  // the first surface for an ID is kept
+  const auto* first = &table[1];
+  check(table.intern(make_surface(surfaces[1].geometryId, 42, 7)) == 1, "interned surface deduplicated");
+  check(table.size() == surfaces.size() && &table[1] == first && table[1].surfaceType == 1 &&
+            table[1].identifier == surfaces[1].identifier,
+        "first surface kept");
+  check(!table.index(0x42) && table.find(0x42) == nullptr, "unknown geometry ID");
+  check_throws<std::invalid_argument>([&] { table.intern(edm4eic::Surface{}); }, "surface without geometry ID");
+
+  // through the parameters of a run frame, in a file
+  {
+    podio::Frame runs;
+    table.write(runs);
+    podio::ROOTWriter writer("test_surface_table.root");
+    writer.writeFrame(runs, "runs");
+    writer.finish();
+  }
+  podio::ROOTReader reader;
+  reader.openFile("test_surface_table.root");
+  const auto runs = podio::Frame(reader.readNextEntry("runs"));
+  check_same_table(edm4eic::surface_table::read(runs), table, "table read from a file");
+  for (const auto& surface : surfaces) {
+    check(same_surface(*edm4eic::surface_table::read(runs).find(surface.geometryId), surface), "64-bit IDs");
+  }
+
+  // under another name, in memory
+  podio::GenericParameters parameters;
+  table.write(parameters, "TrackerSurfaces");
+  check_same_table(edm4eic::surface_table::read(parameters, "TrackerSurfaces"), table, "table read from parameters");
+  check_throws<std::runtime_error>([&] { edm4eic::surface_table::read(parameters); }, "missing parameters");
+  parameters.set("TrackerSurfaces__geometryIdLow", std::vector<int>{1, 2});
+  check_throws<std::runtime_error>([&] { edm4eic::surface_table::read(parameters, "TrackerSurfaces"); },
+                                   "inconsistent parameters");
+  parameters.set("TrackerSurfaces__geometryIdLow", std::vector<int>{1, 2, 3, 4});
+  parameters.set("TrackerSurfaces__transform", std::vector<double>(16 * 4 - 1));
+  check_throws<std::runtime_error>([&] { edm4eic::surface_table::read(parameters, "TrackerSurfaces"); },
+                                   "inconsistent transform parameters");
+
+  std::cout << "surface_table checks passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <edm4eic/TensorCollection.h>
+#include <edm4eic/tensor_utils.h>
+
+#include "check.h"
+
+namespace {
+
+template <typename T> std::vector<T> values(std::span<const T> span) { return {span.begin(), span.end()}; }
+
+} // namespace
+
+int main() {
+  // a tensor of two rows of three values
+  edm4eic::TensorCollection inputs;
+  auto tensor = inputs.create();
+  tensor.setElementType(static_cast<int32_t>(edm4eic::tensor_element_type::float32));
+  tensor.addToShape(2);
+  tensor.addToShape(3);
+  for (int i = 0; i < 6; ++i) {
+    tensor.addToFloatData(static_cast<float>(i));
+  }
+
+  const auto v = edm4eic::view<float>(tensor);
+  check(values(v.shape) == std::vector<int64_t>{2, 3} && values(v.data) == std::vector<float>{0, 1, 2, 3, 4, 5},
+        "view of a tensor");
+  check(v.data.data() == &*tensor.getFloatData().begin(), "view without copying");
+  check_throws<std::invalid_argument>([&] { edm4eic::view<int64_t>(tensor); }, "view of another element type");
+
+  // events of 2, 0 and 4 rows, padded to 5 rows
+  edm4eic::tensor_batch<float> batch({3}, 4, 5, -1.f);
+  check(reinterpret_cast<std::uintptr_t>(batch.data().data()) % edm4eic::tensor_batch<float>::alignment == 0,
+        "aligned buffer");
+  check(batch.add(tensor) == 0, "event from a tensor");
+  check(batch.add_rows({}, 0) == 1, "event without rows");
+  const std::vector<float> x{10, 11, 12, 13}, y{20, 21, 22, 23}, z{30, 31, 32, 33};
+  const std::vector<std::span<const float>> columns{x, y, z};
+  check(batch.add_columns(columns) == 2, "event from columns");
+
+  check(batch.shape() == std::vector<int64_t>{3, 5, 3}, "batch shape");
+  check(batch.rows(0) == 2 && batch.rows(1) == 0 && batch.rows(2) == 4, "rows per event");
+  std::vector<float> expected(3 * 5 * 3, -1.f);
+  for (int i = 0; i < 6; ++i) {
+    expected[i] = static_cast<float>(i);
+  }
+  for (std::size_t r = 0; r < 4; ++r) {
+    expected[2 * 15 + r * 3 + 0] = x[r];
+    expected[2 * 15 + r * 3 + 1] = y[r];
+    expected[2 * 15 + r * 3 + 2] = z[r];
+  }
+  check(values(std::span<const float>{batch.data()}) == expected, "rows followed by padding");
+  check(values(batch.mask()) == std::vector<uint8_t>{1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 0}, "mask");
+
+  // wrong rows are rejected without adding an event
+  edm4eic::TensorCollection others;
+  auto other = others.create();
+  other.setElementType(static_cast<int32_t>(edm4eic::tensor_element_type::float32));
+  other.addToShape(1);
+  other.addToShape(2);
+  other.addToFloatData(1);
+  other.addToFloatData(2);
+  check_throws<std::invalid_argument>([&] { batch.add(other); }, "tensor of another row shape");
+  check_throws<std::length_error>([&] { batch.add_rows(std::vector<float>(18), 6); }, "event of too many rows");
+  check(batch.events() == 3, "no event added by rejected rows");
+
+  // a per-row output splits back into the events, without the padding
+  const std::vector<int64_t> row_shape{3};
+  const auto split = batch.split_rows<float>(batch.data(), row_shape);
+  check(split.size() == 3, "one collection per event");
+  const auto first = edm4eic::view<float>(split[0][0]);
+  check(values(first.shape) == values(v.shape) && values(first.data) == values(v.data), "round trip of a tensor");
+  check(values(edm4eic::view<float>(split[1][0]).shape) == std::vector<int64_t>{0, 3}, "round trip of no rows");
+  const auto third = edm4eic::view<float>(split[2][0]);
+  check(values(third.shape) == std::vector<int64_t>{4, 3} && third.data[3 * 3 + 1] == y[3],
+        "round trip of columns");
+
+  // a per-event output
+  const std::vector<int64_t> scores{7, 8, 9};
+  const std::vector<int64_t> score_shape{1};
+  const auto per_event = batch.split_events<int64_t>(scores, score_shape);
+  check(per_event.size() == 3 && edm4eic::view<int64_t>(per_event[2][0]).data[0] == 9, "per-event output");
+  check_throws<std::invalid_argument>(
+      [&] { batch.split_events<int64_t>(std::span<const int64_t>{scores}.first(2), score_shape); },
+      "output of another size");
+
+  check(batch.add_rows({}, 0) == 3 && batch.full(), "full batch");
+  check_throws<std::length_error>([&] { batch.add(tensor); }, "event beyond the batch");
+
+  // reused for the next batch, with the padding restored
+  batch.clear();
+  check(batch.events() == 0 && batch.data().empty(), "cleared batch");
+  batch.add_rows(std::vector<float>{5, 6, 7}, 1);
+  std::vector<float> refilled(15, -1.f);
+  refilled[0] = 5;
+  refilled[1] = 6;
+  refilled[2] = 7;
+  check(values(std::span<const float>{batch.data()}) == refilled, "padding restored by clear()");
+  check(values(batch.mask()) == std::vector<uint8_t>{1, 0, 0, 0, 0}, "mask restored by clear()");
+
+  std::cout << "tensor_utils checks passed" << std::endl;
+  return 0;
+}
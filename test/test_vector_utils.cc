@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <vector>
+
+#include <edm4hep/Vector3f.h>
+
+#include <edm4eic/vector_utils.h>
+
+#include "check.h"
+
+namespace {
+
+void test_fast_log() {
+  // positive normal floats over the full exponent range
+  double max_error = 0;
+  for (float x = 1e-37f; x < 1e37f; x *= 1.0007f) {
+    const double expected = std::log(double(x));
+    max_error = std::max(max_error, std::fabs(edm4eic::fast::log(x) - expected) / std::max(std::fabs(expected), 1.));
+  }
+  check_close(max_error, 0, 2e-7, "fast::log against std::log");
+
+  // close to 1, where the absolute error matters
+  for (float x = 0.9f; x < 1.1f; x += 1e-5f) {
+    check_close(edm4eic::fast::log(x), std::log(double(x)), 2e-7, "fast::log close to 1");
+  }
+}
+
+void test_fast_eta() {
+  std::vector<edm4hep::Vector3f> vectors;
+  for (double eta = -10; eta <= 10; eta += 1e-3) {
+    for (const double phi : {-3., -1., 0.5, 2.}) {
+      vectors.push_back({static_cast<float>(3 * std::cos(phi)), static_cast<float>(3 * std::sin(phi)),
+                         static_cast<float>(3 * std::sinh(eta))});
+    }
+  }
+  // the batched exact version is evaluated in double precision
+  std::vector<double> expected(vectors.size());
+  std::vector<float> fast(vectors.size());
+  edm4eic::eta(vectors, expected);
+  edm4eic::fast::eta(vectors, fast);
+  double max_error = 0;
+  for (std::size_t i = 0; i < vectors.size(); ++i) {
+    max_error = std::max(max_error, std::fabs(fast[i] - expected[i]));
+    check(fast[i] == edm4eic::fast::eta(vectors[i]), "batched and single fast::eta agree");
+  }
+  check_close(max_error, 0, 2e-6, "fast::eta against eta");
+
+  check(std::isinf(edm4eic::fast::eta(0.f, 0.f, 1.f)) && edm4eic::fast::eta(0.f, 0.f, 1.f) > 0, "+infinity along +z");
+  check(std::isinf(edm4eic::fast::eta(0.f, 0.f, -1.f)) && edm4eic::fast::eta(0.f, 0.f, -1.f) < 0, "-infinity along -z");
+
+  // the batched exact version agrees along the beam axis
+  const std::vector<edm4hep::Vector3f> axis{{0, 0, 1}, {0, 0, -1}};
+  std::vector<double> axis_eta(axis.size());
+  edm4eic::eta(axis, axis_eta);
+  check(std::isinf(axis_eta[0]) && axis_eta[0] > 0 && std::isinf(axis_eta[1]) && axis_eta[1] < 0,
+        "batched eta +-infinity along the beam axis");
+}
+
+} // namespace
+
+int main() {
+  test_fast_log();
+  test_fast_eta();
+  std::cout << "vector utils checks passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <edm4eic/RawCALOROCHitCollection.h>
+#include <edm4eic/SimPulseCollection.h>
+#include <edm4eic/waveform_utils.h>
+
+#include "check.h"
+
+namespace {
+
+using edm4eic::no_sample;
+
+// four hits of five samples, except for hit 1 without samples: a regular
+// pulse, a hit that saturated the ADC (CALOROC1A) or the high gain
+// (CALOROC1B), and a pulse without TOA whose peak is repeated
+edm4eic::RawCALOROCHitCollection make_hits() {
+  const std::vector<std::vector<uint16_t>> adc{
+      {10, 50, 200, 120, 30}, {}, {10, 1023, 1023, 1023, 20}, {12, 8, 14, 40, 40}};
+  const std::vector<std::vector<uint16_t>> toa_a{{0, 0, 512, 0, 0}, {}, {0, 100, 0, 0, 0}, {0, 0, 0, 0, 0}};
+  const std::vector<std::vector<uint16_t>> tot{{0, 0, 0, 0, 0}, {}, {0, 0, 0, 300, 0}, {0, 0, 0, 0, 0}};
+  const std::vector<std::vector<uint16_t>> low{{5, 20, 60, 40, 10}, {}, {5, 200, 400, 100, 10}, {6, 6, 6, 6, 6}};
+  const std::vector<std::vector<uint16_t>> high{
+      {40, 300, 900, 600, 100}, {}, {40, 1023, 1023, 800, 100}, {41, 41, 45, 41, 41}};
+  const std::vector<std::vector<uint16_t>> toa_b{{0, 0, 0, 256, 0}, {}, {0, 0, 0, 0, 0}, {0, 0, 0, 0, 0}};
+
+  edm4eic::RawCALOROCHitCollection hits;
+  for (std::size_t i = 0; i < adc.size(); ++i) {
+    auto hit = hits.create();
+    hit.setCellID(i);
+    for (std::size_t s = 0; s < adc[i].size(); ++s) {
+      hit.addToASamples({adc[i][s], toa_a[i][s], tot[i][s]});
+      hit.addToBSamples({low[i][s], high[i][s], toa_b[i][s]});
+    }
+  }
+  return hits;
+}
+
+void test_kernels(const edm4eic::caloroc1a_samples& samples) {
+  check(samples.hits() == 4 && samples.offsets == std::vector<uint32_t>{0, 5, 5, 10, 15}, "sample offsets");
+  check(samples.adc.size() == 15 && samples.adc[5] == 10 && samples.tot[8] == 300, "packed samples");
+
+  // the first of repeated maxima, and no sample for the empty hit
+  std::vector<uint16_t> value(4);
+  std::vector<uint32_t> sample(4);
+  edm4eic::peak<uint16_t>(samples.offsets, samples.adc, value, sample);
+  check(value == std::vector<uint16_t>{200, 0, 1023, 40}, "peak values");
+  check(sample == std::vector<uint32_t>{2, no_sample, 1, 3}, "peak samples");
+
+  std::vector<float> mean(4);
+  edm4eic::leading_mean(samples.offsets, samples.adc, 3, mean);
+  check_close(mean[0], 260. / 3, 1e-4, "leading mean");
+  check(mean[1] == 0, "leading mean without samples");
+  check_close(mean[3], 34. / 3, 1e-5, "leading mean of the last hit");
+  edm4eic::leading_mean(samples.offsets, samples.adc, 10, mean);
+  check_close(mean[3], 114. / 5, 1e-5, "leading mean of fewer samples than requested");
+
+  const std::vector<float> pedestal{10, 1000, 20, 12};
+  std::vector<float> subtracted(samples.adc.size());
+  edm4eic::subtract_pedestal(samples.offsets, samples.adc, pedestal, subtracted);
+  check(subtracted[2] == 190 && subtracted[5] == -10 && subtracted[14] == 28, "pedestal of the own hit");
+
+  std::vector<uint16_t> first(4);
+  edm4eic::first_nonzero(samples.offsets, samples.toa, sample, first);
+  check(sample == std::vector<uint32_t>{2, no_sample, 1, no_sample}, "first TOA samples");
+  check(first == std::vector<uint16_t>{512, 0, 100, 0}, "first TOA values");
+  edm4eic::first_nonzero(samples.offsets, samples.tot, sample, first);
+  check(sample == std::vector<uint32_t>{no_sample, no_sample, 3, no_sample} && first[2] == 300, "first TOT");
+
+  std::vector<uint16_t> too_few(3);
+  check_throws<std::invalid_argument>(
+      [&] { edm4eic::peak<uint16_t>(samples.offsets, samples.adc, too_few, sample); }, "inconsistent hit count");
+  check_throws<std::invalid_argument>(
+      [&] { edm4eic::subtract_pedestal(samples.offsets, samples.adc, pedestal, mean); }, "inconsistent sample count");
+}
+
+void test_caloroc1a(const edm4eic::caloroc1a_samples& samples) {
+  const float lsb = 25.f / 1024;
+  edm4eic::caloroc1a_settings settings;
+  settings.pedestal = 10;
+  settings.tot_scale = 8;
+  const auto hits = edm4eic::reconstruct(samples, settings);
+  check(hits.amplitude == std::vector<float>{190, 0, 2400, 30}, "CALOROC1A amplitudes");
+  check(hits.gain == std::vector<uint8_t>{0, 0, 1, 0}, "TOT used for the saturated hit");
+  check_close(hits.time[0], 2 * 25 + 512 * lsb, 1e-5, "time from the TOA");
+  check(hits.time[1] == 0, "no time without samples");
+  check_close(hits.time[2], 25 + 100 * lsb, 1e-5, "time of the saturated hit");
+  check(hits.time[3] == 3 * 25, "time of the first peak sample without TOA");
+
+  settings.pedestal_samples = 3;
+  const auto estimated = edm4eic::reconstruct(samples, settings);
+  check_close(estimated.amplitude[3], 40 - 34. / 3, 1e-5, "estimated pedestal");
+  check(estimated.amplitude[1] == 0 && estimated.amplitude[2] == 2400, "TOT without pedestal");
+}
+
+void test_caloroc1b(const edm4eic::caloroc1b_samples& samples) {
+  edm4eic::caloroc1b_settings settings;
+  settings.pedestal_low = 5;
+  settings.pedestal_high = 40;
+  settings.gain_ratio = 10;
+  const auto hits = edm4eic::reconstruct(samples, settings);
+  check(hits.amplitude == std::vector<float>{860, 0, 3950, 5}, "CALOROC1B amplitudes");
+  check(hits.gain == std::vector<uint8_t>{0, 0, 1, 0}, "low gain used for the saturated hit");
+  check_close(hits.time[0], 3 * 25 + 256 * 25.f / 1024, 1e-5, "time from the TOA");
+  check(hits.time[1] == 0, "no time without samples");
+  check(hits.time[2] == 2 * 25, "time of the low gain peak");
+  check(hits.time[3] == 2 * 25, "time of the high gain peak");
+
+  // the gain switches at the saturation
+  settings.saturation = 900;
+  check(edm4eic::reconstruct(samples, settings).gain == std::vector<uint8_t>{1, 0, 1, 0}, "gain switch at saturation");
+}
+
+void test_pulses() {
+  // a parabola sampled every 2 ns from 10 ns with its maximum at 14.6 ns, an
+  // empty pulse and a pulse that peaks in its first sample
+  edm4eic::SimPulseCollection pulses;
+  auto parabola = pulses.create();
+  parabola.setTime(10);
+  parabola.setInterval(2);
+  for (int s = 0; s < 6; ++s) {
+    parabola.addToAmplitude(100 - (s - 2.3f) * (s - 2.3f));
+  }
+  auto empty = pulses.create();
+  empty.setTime(5);
+  empty.setInterval(2);
+  auto falling = pulses.create();
+  falling.setTime(1);
+  falling.setInterval(4);
+  for (const float a : {3.f, 2.f, 1.f}) {
+    falling.addToAmplitude(a);
+  }
+
+  const auto samples = edm4eic::pulse_columns(pulses);
+  check(samples.hits() == 3 && samples.offsets == std::vector<uint32_t>{0, 6, 6, 9}, "pulse offsets");
+  check(samples.start == std::vector<float>{10, 5, 1} && samples.interval == std::vector<float>{2, 2, 4},
+        "pulse times");
+
+  const auto hits = edm4eic::reconstruct(samples);
+  check_close(hits.amplitude[0], 100 - 0.3 * 0.3, 1e-4, "peak sample amplitude");
+  check_close(hits.time[0], 14.6, 1e-4, "interpolated time of the maximum");
+  check(hits.amplitude[1] == 0 && hits.time[1] == 5, "empty pulse at its start");
+  check(hits.amplitude[2] == 3 && hits.time[2] == 1, "no interpolation at the first sample");
+}
+
+} // namespace
+
+int main() {
+  const auto hits = make_hits();
+  test_kernels(edm4eic::caloroc1a_columns(hits));
+  test_caloroc1a(edm4eic::caloroc1a_columns(hits));
+  test_caloroc1b(edm4eic::caloroc1b_columns(hits));
+  test_pulses();
+
+  std::cout << "waveform_utils checks passed" << std::endl;
+  return 0;
+}
@@ -2,6 +2,8 @@
 
 #include "write_events.h"
 
+#include <edm4eic/async_writer.h>
+
 #include <podio/podioVersion.h>
 #if PODIO_BUILD_VERSION >= PODIO_VERSION(0, 99, 0)
 #include <podio/ROOTWriter.h>
@@ -15,4 +17,8 @@ using ROOTWriter = podio::ROOTFrameWriter;
 int main(int argc, char *argv[]) {
 
   write<podio::ROOTWriter>("edm4eic_events.root");
+
+  // the same events, serialized and compressed on a separate thread as a
+  // reconstruction output stage would
+  write<edm4eic::async_writer<podio::ROOTWriter>>("edm4eic_events_async.root");
 }
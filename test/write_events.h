@@ -4,15 +4,29 @@
 #define EDM4EIC_TEST_WRITE_EVENTS_H
 
 // Data model
+#include "edm4eic/MCRecoTrackerHitAssociationCollection.h"
 #include "edm4eic/RawTrackerHitCollection.h"
+#include "edm4eic/ReconstructedParticleCollection.h"
+#include "edm4eic/TrackParametersCollection.h"
+#include "edm4hep/EDM4hepVersion.h"
+#include "edm4hep/MCParticleCollection.h"
+#include "edm4hep/SimTrackerHitCollection.h"
+
+// Utilities
+#include "edm4eic/analysis_utils.h"
 
 // STL
 #include <iostream>
+#include <utility>
 #include <vector>
 
 // podio specific includes
 #include "podio/Frame.h"
 
+// times [ns] of the simulated hits and particles, which merging shifts
+constexpr float sim_hit_time = 1.5f;
+constexpr float mc_particle_time = 0.5f;
+
 template <class WriterT>
 void write(std::string outfilename) {
   std::cout << "start processing" << std::endl;
@@ -38,13 +52,70 @@ void write(std::string outfilename) {
               << " of type " << raw_hits.getValueTypeName() << "\n\n"
               << raw_hits << std::endl;
 
+    // a decay, with the simulated hit of the daughter, for merging; the
+    // energy deposit is the event number, which identifies the merged hits
+    auto particles_mc = edm4hep::MCParticleCollection();
+    auto parent = particles_mc.create();
+    auto daughter = particles_mc.create();
+    parent.setTime(mc_particle_time);
+    daughter.setTime(mc_particle_time);
+    parent.addToDaughters(daughter);
+    daughter.addToParents(parent);
+
+    // a relation across collections, for the skimming round trip
+    auto sim_hits = edm4hep::SimTrackerHitCollection();
+    auto sim_hit = sim_hits.create();
+    sim_hit.setCellID(raw_hit.getCellID());
+    sim_hit.setTime(sim_hit_time);
+    sim_hit.setEDep(i);
+#if EDM4HEP_BUILD_VERSION >= EDM4HEP_VERSION(0, 99, 0)
+    sim_hit.setParticle(daughter);
+#else
+    sim_hit.setMCParticle(daughter);
+#endif
+    auto associations = edm4eic::MCRecoTrackerHitAssociationCollection();
+    auto association = associations.create();
+    association.setWeight(1);
+    association.setRawHit(raw_hit);
+    association.setSimHit(sim_hit);
+
+    // track parameters, one of them without momentum, and the pions made of
+    // the others, for the RDataFrame columns
+    std::vector<edm4eic::TrackParametersData> track_data(3);
+    auto tracks = edm4eic::TrackParametersCollection();
+    for (unsigned k = 0; k < track_data.size(); ++k) {
+      track_data[k].theta = 0.3f + 1.1f * k + 0.02f * i;
+      track_data[k].phi = -2.9f + 2.3f * k + 0.05f * i;
+      track_data[k].qOverP = k == 2 ? 0.f : (k == 0 ? 1.f : -1.f) / (0.5f + i + k);
+      auto track = tracks.create();
+      track.setTheta(track_data[k].theta);
+      track.setPhi(track_data[k].phi);
+      track.setQOverP(track_data[k].qOverP);
+    }
+    auto particles = edm4eic::ReconstructedParticleCollection();
+    for (const auto& momentum : edm4eic::momenta_from_tracking(track_data, 0.13957)) {
+      if (momentum.P() == 0) {
+        continue;
+      }
+      auto particle = particles.create();
+      particle.setMomentum({static_cast<float>(momentum.Px()), static_cast<float>(momentum.Py()),
+                            static_cast<float>(momentum.Pz())});
+      particle.setEnergy(static_cast<float>(momentum.E()));
+      particle.setMass(static_cast<float>(momentum.M()));
+    }
+
     event.put(std::move(raw_hits), "RawTrackerHits");
+    event.put(std::move(particles_mc), "MCParticles");
+    event.put(std::move(sim_hits), "SimTrackerHits");
+    event.put(std::move(associations), "RawTrackerHitAssociations");
+    event.put(std::move(tracks), "TrackParameters");
+    event.put(std::move(particles), "ReconstructedParticles");
 
     //===============================================================================
 
     event.putParameter("EventType", "test");
 
-    writer.writeFrame(event, "events");
+    writer.writeFrame(std::move(event), "events");
   }
 
   writer.finish();
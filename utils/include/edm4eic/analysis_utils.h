@@ -5,9 +5,14 @@
 #define EDM4EIC_UTILS_ANALYSIS_HH
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <limits>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -42,5 +47,136 @@ momenta_from_tracking(const std::vector<edm4eic::TrackParametersData>& tracks,
                  });
   return momenta;
 }
+
+namespace detail {
+
+/** Single-precision sincos without branches.
+ * Cody-Waite reduction to [-pi/4, pi/4] followed by the Cephes minimax
+ * polynomials; the quadrant is applied with selects so that loops calling
+ * this can be auto-vectorized (GCC additionally needs -fno-trapping-math).
+ * The absolute error is below 1e-7 for |x| < 100, which covers any
+ * theta/phi, and degrades slowly for larger arguments.
+ */
+inline void sincos_fast(const float x, float& s, float& c) {
+  const float t = x * 0.63661977236758134f; // 2/pi
+  const int32_t quadrant = static_cast<int32_t>(t + std::copysign(0.5f, t));
+  const float q = static_cast<float>(quadrant);
+  float r = x - q * 1.5703125f;
+  r -= q * 4.837512969970703125e-4f;
+  r -= q * 7.54978995489188216e-8f;
+  const float r2 = r * r;
+  const float sr =
+      r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+  const float cr = 1.f - 0.5f * r2 +
+                   r2 * r2 *
+                       (4.166664568298827e-2f +
+                        r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+  const bool swap = quadrant & 1;
+  const float sign_s = 1.f - 2.f * static_cast<float>((quadrant >> 1) & 1);
+  const float sign_c = 1.f - 2.f * static_cast<float>(((quadrant + 1) >> 1) & 1);
+  s = sign_s * (swap ? cr : sr);
+  c = sign_c * (swap ? sr : cr);
+}
+
+// momentum components of one block of tracks, |qOverP| < 1e-9 gives zero momentum
+inline void momenta_kernel(const float* __restrict theta, const float* __restrict phi,
+                           const float* __restrict qOverP, double* __restrict px,
+                           double* __restrict py, double* __restrict pz, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    float sin_theta, cos_theta, sin_phi, cos_phi;
+    sincos_fast(theta[i], sin_theta, cos_theta);
+    sincos_fast(phi[i], sin_phi, cos_phi);
+    const float a = std::fabs(qOverP[i]);
+    const float inv = 1.f / std::max(a, 1e-9f);
+    const float p = a < 1e-9f ? 0.f : inv;
+    px[i] = p * cos_phi * sin_theta;
+    py[i] = p * sin_phi * sin_theta;
+    pz[i] = p * cos_theta;
+  }
+}
+
+// energies for every mass hypothesis, hypothesis-major
+inline void energy_kernel(const double* __restrict px, const double* __restrict py,
+                          const double* __restrict pz, std::span<const double> masses,
+                          double* __restrict energy, std::size_t n, std::size_t stride) {
+  for (std::size_t m = 0; m < masses.size(); ++m) {
+    const double m2 = masses[m] * masses[m];
+    double* __restrict e = energy + m * stride;
+    for (std::size_t i = 0; i < n; ++i) {
+      e[i] = std::sqrt(px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i] + m2);
+    }
+  }
+}
+
+} // namespace detail
+
+/** Batched four momenta from columnar track parameters.
+ * Computes the momentum of N tracks from the theta, phi and qOverP columns
+ * into caller-provided px/py/pz buffers of size N, without allocating.
+ * For every mass hypothesis in `masses` the energies are written to
+ * `energy`, hypothesis-major: energy[m * N + i] belongs to track i with
+ * mass masses[m], so `energy` must hold masses.size() * N values. As in
+ * the vector overload, tracks with |qOverP| < 1e-9 get zero momentum.
+ * The trigonometry runs in single precision (see detail::sincos_fast),
+ * matching the precision of the stored track parameters.
+ */
+inline void momenta_from_tracking(std::span<const float> theta, std::span<const float> phi,
+                                  std::span<const float> qOverP, std::span<const double> masses,
+                                  std::span<double> px, std::span<double> py,
+                                  std::span<double> pz, std::span<double> energy) {
+  const std::size_t n = theta.size();
+  if (phi.size() != n || qOverP.size() != n || px.size() < n || py.size() < n || pz.size() < n ||
+      energy.size() < masses.size() * n) {
+    throw std::invalid_argument("momenta_from_tracking: inconsistent buffer sizes");
+  }
+  detail::momenta_kernel(theta.data(), phi.data(), qOverP.data(), px.data(), py.data(), pz.data(),
+                         n);
+  detail::energy_kernel(px.data(), py.data(), pz.data(), masses, energy.data(), n, n);
+}
+
+/// Single mass hypothesis
+inline void momenta_from_tracking(std::span<const float> theta, std::span<const float> phi,
+                                  std::span<const float> qOverP, const double mass,
+                                  std::span<double> px, std::span<double> py,
+                                  std::span<double> pz, std::span<double> energy) {
+  momenta_from_tracking(theta, phi, qOverP, std::span<const double>{&mass, 1}, px, py, pz, energy);
+}
+
+/** Batched four momenta from a TrackParametersCollection.
+ * Same as the columnar overload, with the columns gathered from the
+ * collection in fixed-size blocks on the stack.
+ */
+inline void momenta_from_tracking(const edm4eic::TrackParametersCollection& tracks,
+                                  std::span<const double> masses, std::span<double> px,
+                                  std::span<double> py, std::span<double> pz,
+                                  std::span<double> energy) {
+  const std::size_t n = tracks.size();
+  if (px.size() < n || py.size() < n || pz.size() < n || energy.size() < masses.size() * n) {
+    throw std::invalid_argument("momenta_from_tracking: inconsistent buffer sizes");
+  }
+  constexpr std::size_t block = 256;
+  std::array<float, block> theta, phi, qOverP;
+  for (std::size_t first = 0; first < n; first += block) {
+    const std::size_t count = std::min(block, n - first);
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto track = tracks[first + i];
+      theta[i] = track.getTheta();
+      phi[i] = track.getPhi();
+      qOverP[i] = track.getQOverP();
+    }
+    detail::momenta_kernel(theta.data(), phi.data(), qOverP.data(), px.data() + first,
+                           py.data() + first, pz.data() + first, count);
+    detail::energy_kernel(px.data() + first, py.data() + first, pz.data() + first, masses,
+                          energy.data() + first, count, n);
+  }
+}
+
+/// Single mass hypothesis
+inline void momenta_from_tracking(const edm4eic::TrackParametersCollection& tracks,
+                                  const double mass, std::span<double> px, std::span<double> py,
+                                  std::span<double> pz, std::span<double> energy) {
+  momenta_from_tracking(tracks, std::span<const double>{&mass, 1}, px, py, pz, energy);
+}
+
 } // namespace edm4eic
 #endif
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_ASSOCIATION_INDEX_HH
+#define EDM4EIC_UTILS_ASSOCIATION_INDEX_HH
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <podio/ObjectID.h>
+
+namespace edm4eic {
+
+namespace detail {
+
+// The two ends of an association or link, as (rec, sim)
+template <typename AssocT> auto association_ends(const AssocT& a) {
+  if constexpr (requires { a.getFrom(); a.getTo(); }) {
+    return std::pair{a.getFrom(), a.getTo()};
+  } else if constexpr (requires { a.getRec(); a.getSim(); }) {
+    return std::pair{a.getRec(), a.getSim()};
+  } else if constexpr (requires { a.getRawHit(); a.getSimHit(); }) {
+    return std::pair{a.getRawHit(), a.getSimHit()};
+  } else {
+    // as TrackClusterLink, which is from the cluster to the track
+    return std::pair{a.getCluster(), a.getTrack()};
+  }
+}
+
+} // namespace detail
+
+/// A weighted association or link with from/to, rec/sim, rawHit/simHit or cluster/track ends
+template <typename AssocT>
+concept Association = requires(const AssocT& a) {
+  { a.getWeight() } -> std::convertible_to<float>;
+} && (requires(const AssocT& a) { a.getFrom(); a.getTo(); } || requires(const AssocT& a) { a.getRec(); a.getSim(); } ||
+      requires(const AssocT& a) { a.getRawHit(); a.getSimHit(); } ||
+      requires(const AssocT& a) { a.getCluster(); a.getTrack(); });
+
+namespace detail {
+
+/// ObjectID -> matches, in CSR layout per collection ID
+template <typename MatchT> class object_multimap {
+public:
+  void build(std::vector<std::pair<podio::ObjectID, MatchT>>& pairs) {
+    std::sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) {
+      if (a.first.collectionID != b.first.collectionID) {
+        return a.first.collectionID < b.first.collectionID;
+      }
+      if (a.first.index != b.first.index) {
+        return a.first.index < b.first.index;
+      }
+      return a.second.weight > b.second.weight;
+    });
+    m_matches.clear();
+    m_matches.reserve(pairs.size());
+    m_collections.clear();
+    for (const auto& [id, match] : pairs) {
+      if (m_collections.empty() || m_collections.back().id != id.collectionID) {
+        close_collection();
+        m_collections.push_back({id.collectionID, {}});
+      }
+      // offsets[i] .. offsets[i + 1] are the matches of object i; objects
+      // that are not in a collection have no index
+      if (id.index < 0) {
+        continue;
+      }
+      auto& offsets = m_collections.back().offsets;
+      while (offsets.size() <= static_cast<std::size_t>(id.index)) {
+        offsets.push_back(static_cast<uint32_t>(m_matches.size()));
+      }
+      m_matches.push_back(match);
+    }
+    close_collection();
+  }
+
+  std::span<const MatchT> operator()(const podio::ObjectID id) const {
+    for (const auto& collection : m_collections) {
+      if (collection.id != id.collectionID) {
+        continue;
+      }
+      const auto i = static_cast<std::size_t>(id.index);
+      if (id.index < 0 || i + 1 >= collection.offsets.size()) {
+        return {};
+      }
+      return std::span<const MatchT>{m_matches}.subspan(
+          collection.offsets[i], collection.offsets[i + 1] - collection.offsets[i]);
+    }
+    return {};
+  }
+
+private:
+  void close_collection() {
+    if (!m_collections.empty()) {
+      m_collections.back().offsets.push_back(static_cast<uint32_t>(m_matches.size()));
+    }
+  }
+
+  struct collection_offsets {
+    uint32_t id;
+    std::vector<uint32_t> offsets;
+  };
+  std::vector<collection_offsets> m_collections; // a handful at most, scanned linearly
+  std::vector<MatchT> m_matches;
+};
+
+} // namespace detail
+
+/** Bidirectional index of an association or link collection.
+ * Built in one pass over a MCReco*Association or MCReco*Link collection (or
+ * any collection of an Association: rec/sim, rawHit/simHit, cluster/track
+ * or from/to ends and a weight). For every object on either side the
+ * matches are stored contiguously, sorted by decreasing weight, and found in
+ * O(1) from its ObjectID: objects of one collection have dense indices, so
+ * each side is a flat offset table per collection. For links, rec is the
+ * From and sim the To side; for TrackClusterMatch, as for TrackClusterLink,
+ * rec is the cluster and sim the track.
+ */
+class association_index {
+public:
+  struct match {
+    podio::ObjectID id;   // the object on the other side
+    float weight;
+    uint32_t association; // index in the association collection
+  };
+
+  association_index() = default;
+
+  template <typename CollT>
+    requires Association<std::remove_cvref_t<decltype(std::declval<const CollT&>()[0])>>
+  explicit association_index(const CollT& associations) {
+    std::vector<std::pair<podio::ObjectID, match>> by_rec, by_sim;
+    by_rec.reserve(associations.size());
+    by_sim.reserve(associations.size());
+    for (std::size_t i = 0; i < associations.size(); ++i) {
+      const auto assoc = associations[i];
+      const auto [rec, sim] = detail::association_ends(assoc);
+      if (!rec.isAvailable() || !sim.isAvailable()) {
+        ++m_incomplete;
+        continue;
+      }
+      // objects that are not in any collection are available, but cannot be looked up
+      const auto rec_id = rec.getObjectID(), sim_id = sim.getObjectID();
+      if (rec_id.index < 0 || sim_id.index < 0) {
+        ++m_incomplete;
+        continue;
+      }
+      const float weight = assoc.getWeight();
+      const auto index = static_cast<uint32_t>(i);
+      by_rec.push_back({rec_id, {sim_id, weight, index}});
+      by_sim.push_back({sim_id, {rec_id, weight, index}});
+    }
+    m_by_rec.build(by_rec);
+    m_by_sim.build(by_sim);
+  }
+
+  /// Sim objects matched to a rec object, highest weight first
+  std::span<const match> sim_of(const podio::ObjectID rec) const { return m_by_rec(rec); }
+  /// Rec objects matched to a sim object, highest weight first
+  std::span<const match> rec_of(const podio::ObjectID sim) const { return m_by_sim(sim); }
+
+  template <typename ObjT> std::span<const match> sim_of(const ObjT& rec) const {
+    return sim_of(rec.getObjectID());
+  }
+  template <typename ObjT> std::span<const match> rec_of(const ObjT& sim) const {
+    return rec_of(sim.getObjectID());
+  }
+
+  /// Highest-weight match, if any
+  template <typename KeyT> std::optional<match> best_sim(const KeyT& rec) const {
+    const auto matches = sim_of(rec);
+    return matches.empty() ? std::nullopt : std::optional<match>{matches.front()};
+  }
+  template <typename KeyT> std::optional<match> best_rec(const KeyT& sim) const {
+    const auto matches = rec_of(sim);
+    return matches.empty() ? std::nullopt : std::optional<match>{matches.front()};
+  }
+
+  /// Associations skipped because one of their ends was not set, or not in a collection
+  std::size_t incomplete() const { return m_incomplete; }
+
+private:
+  detail::object_multimap<match> m_by_rec;
+  detail::object_multimap<match> m_by_sim;
+  std::size_t m_incomplete{0};
+};
+
+} // namespace edm4eic
+
+#endif
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_ASYNC_WRITER_HH
+#define EDM4EIC_UTILS_ASYNC_WRITER_HH
+
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <podio/Frame.h>
+
+#include <edm4eic/bounded_queue.h>
+
+namespace edm4eic {
+
+/** Asynchronous frame writer.
+ * Wraps a podio writer (e.g. podio::ROOTWriter) so that serialization and
+ * compression run on a dedicated thread. Producers hand frames over a
+ * bounded queue and block in writeFrame() only while `queue_size` frames
+ * are pending, which bounds the memory held. Frames are written in the
+ * order in which writeFrame() was called; several producer threads may
+ * call it concurrently, but not concurrently with finish(). The wrapped
+ * writer is only used from the writer thread after construction.
+ *
+ * Errors of the wrapped writer are rethrown by the next writeFrame() or by
+ * finish(). finish() writes all pending frames and then finishes the
+ * wrapped writer, also after a failed writeFrame(), before rethrowing the
+ * first error; the destructor calls it if needed and discards errors.
+ */
+template <typename WriterT> class async_writer {
+public:
+  template <typename... Args>
+  explicit async_writer(std::size_t queue_size, Args&&... args)
+      : m_writer{std::forward<Args>(args)...}, m_queue{queue_size}, m_thread{[this] { run(); }} {}
+
+  /// Construct with a default queue size, e.g. async_writer<podio::ROOTWriter>{"out.root"}
+  explicit async_writer(const std::string& filename) : async_writer(8, filename) {}
+
+  async_writer(const async_writer&) = delete;
+  async_writer& operator=(const async_writer&) = delete;
+
+  ~async_writer() {
+    try {
+      finish();
+    } catch (...) {
+    }
+  }
+
+  /// Queue a frame for writing, blocking while the queue is full
+  void writeFrame(podio::Frame&& frame, const std::string& category) {
+    enqueue({std::move(frame), category, std::nullopt});
+  }
+
+  /// Queue a frame for writing, with only the given collections
+  void writeFrame(podio::Frame&& frame, const std::string& category,
+                  std::vector<std::string> collections) {
+    enqueue({std::move(frame), category, std::move(collections)});
+  }
+
+  /// Write all pending frames and finish the wrapped writer
+  void finish() {
+    if (m_finished) {
+      rethrow();
+      return;
+    }
+    m_finished = true;
+    m_queue.close();
+    m_thread.join();
+    // also after an error, so that the frames written so far are readable
+    try {
+      m_writer.finish();
+    } catch (...) {
+      std::lock_guard lock{m_error_mutex};
+      if (!m_error) {
+        m_error = std::current_exception();
+      }
+    }
+    rethrow();
+  }
+
+  /// Frames waiting to be written
+  std::size_t pending() const { return m_queue.size(); }
+
+private:
+  struct item {
+    podio::Frame frame;
+    std::string category;
+    std::optional<std::vector<std::string>> collections;
+  };
+
+  void enqueue(item&& it) {
+    if (m_finished) {
+      throw std::logic_error("async_writer: writeFrame() after finish()");
+    }
+    rethrow();
+    if (!m_queue.push(std::move(it))) {
+      rethrow();
+    }
+  }
+
+  void run() {
+    while (auto it = m_queue.pop()) {
+      try {
+        if (it->collections) {
+          m_writer.writeFrame(it->frame, it->category, *it->collections);
+        } else {
+          m_writer.writeFrame(it->frame, it->category);
+        }
+      } catch (...) {
+        {
+          std::lock_guard lock{m_error_mutex};
+          m_error = std::current_exception();
+        }
+        // stop accepting frames, producers see the error on their next call
+        m_queue.close();
+        return;
+      }
+    }
+  }
+
+  void rethrow() {
+    std::lock_guard lock{m_error_mutex};
+    if (m_error) {
+      std::rethrow_exception(m_error);
+    }
+  }
+
+  WriterT m_writer;
+  bounded_queue<item> m_queue;
+  std::mutex m_error_mutex;
+  std::exception_ptr m_error;
+  bool m_finished{false};
+  std::thread m_thread;
+};
+
+} // namespace edm4eic
+
+#endif
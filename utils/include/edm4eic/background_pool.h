@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_BACKGROUND_POOL_HH
+#define EDM4EIC_UTILS_BACKGROUND_POOL_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <edm4eic/frame_splice.h>
+
+namespace edm4eic {
+
+/// How many background events are drawn per signal event, and which
+enum class background_sampling {
+  sequential, // fixed number of events, in file order
+  random,     // fixed number of events, drawn at random
+  poisson     // Poisson-distributed number of events, drawn at random
+};
+
+/// Whether randomly drawn background events may repeat
+enum class background_reuse {
+  replace, // every draw is independent
+  unique,  // no event is drawn twice for the same signal event
+  deck     // every event is drawn once before any event is drawn again
+};
+
+inline background_sampling background_sampling_from_string(std::string_view name) {
+  if (name == "sequential") return background_sampling::sequential;
+  if (name == "random") return background_sampling::random;
+  if (name == "poisson") return background_sampling::poisson;
+  throw std::invalid_argument("unknown background sampling '" + std::string(name) + "'");
+}
+
+inline background_reuse background_reuse_from_string(std::string_view name) {
+  if (name == "replace") return background_reuse::replace;
+  if (name == "unique") return background_reuse::unique;
+  if (name == "deck") return background_reuse::deck;
+  throw std::invalid_argument("unknown background reuse policy '" + std::string(name) + "'");
+}
+
+/** Background event sampler.
+ * Draws the entries of a background source (a file or a background_pool)
+ * to overlay on each consecutive signal event. The sequence of draws
+ * depends only on the seed and the configuration, so merges are
+ * reproducible.
+ */
+class background_sampler {
+public:
+  background_sampler(std::size_t entries, double mean, background_sampling sampling,
+                     background_reuse reuse = background_reuse::replace, uint64_t seed = 0)
+      : m_entries{entries}, m_mean{mean}, m_sampling{sampling}, m_reuse{reuse}, m_rng{seed}, m_poisson{mean > 0 ? mean : 1.} {
+    if (m_entries == 0) {
+      throw std::invalid_argument("background_sampler: no entries to sample from");
+    }
+    m_order.resize(m_entries);
+    std::iota(m_order.begin(), m_order.end(), std::size_t{0});
+    if (m_reuse == background_reuse::deck) {
+      std::shuffle(m_order.begin(), m_order.end(), m_rng);
+    }
+  }
+
+  /// Entries to overlay on the next signal event
+  std::vector<std::size_t> next() { return next(count()); }
+
+  /// Next `n` entries, e.g. one per arrival on a timeline
+  std::vector<std::size_t> next(std::size_t n) {
+    std::vector<std::size_t> entries(n);
+    if (m_sampling == background_sampling::sequential) {
+      for (auto& entry : entries) {
+        entry = m_next++ % m_entries;
+      }
+      return entries;
+    }
+    switch (m_reuse) {
+    case background_reuse::replace: {
+      std::uniform_int_distribution<std::size_t> uniform{0, m_entries - 1};
+      for (auto& entry : entries) {
+        entry = uniform(m_rng);
+      }
+      break;
+    }
+    case background_reuse::unique:
+      // partial Fisher-Yates shuffle, repeating only once all entries are used
+      for (std::size_t i = 0; i < entries.size(); ++i) {
+        const std::size_t k = i % m_entries;
+        std::uniform_int_distribution<std::size_t> uniform{k, m_entries - 1};
+        std::swap(m_order[k], m_order[uniform(m_rng)]);
+        entries[i] = m_order[k];
+      }
+      break;
+    case background_reuse::deck:
+      for (auto& entry : entries) {
+        if (m_next == m_entries) {
+          std::shuffle(m_order.begin(), m_order.end(), m_rng);
+          m_next = 0;
+        }
+        entry = m_order[m_next++];
+      }
+      break;
+    }
+    return entries;
+  }
+
+private:
+  std::size_t count() {
+    if (m_mean <= 0) {
+      return 0;
+    }
+    if (m_sampling == background_sampling::poisson) {
+      return m_poisson(m_rng);
+    }
+    return static_cast<std::size_t>(std::llround(m_mean));
+  }
+
+  std::size_t m_entries;
+  double m_mean;
+  background_sampling m_sampling;
+  background_reuse m_reuse;
+  std::mt19937_64 m_rng;
+  std::poisson_distribution<std::size_t> m_poisson;
+  std::vector<std::size_t> m_order;
+  std::size_t m_next{0};
+};
+
+/** Preloaded background events.
+ * Holds the collection buffers of the first background events of a source,
+ * up to a memory limit. The events are immutable once loaded and can be
+ * spliced by many merge threads at once. Entries from size() on are not in
+ * the pool; a background_sampler still draws from all entries of the
+ * source, and those have to be read on demand.
+ */
+class background_pool {
+public:
+  using event_type = std::shared_ptr<const frame_buffers>;
+
+  /** Load events from `reader` until `max_bytes` would be exceeded.
+   * At least one event is loaded if the source is not empty.
+   */
+  template <typename ReaderT>
+  background_pool(ReaderT& reader, const std::vector<std::string>& names, std::size_t max_bytes,
+                  const std::string& category = "events") {
+    const std::size_t entries = reader.getEntries(category);
+    for (std::size_t i = 0; i < entries; ++i) {
+      auto event = std::make_shared<const frame_buffers>(reader.readEntry(category, i), names);
+      const std::size_t bytes = event->bytes();
+      if (!m_events.empty() && m_bytes + bytes > max_bytes) {
+        break;
+      }
+      m_bytes += bytes;
+      m_events.push_back(std::move(event));
+    }
+  }
+
+  std::size_t size() const { return m_events.size(); }
+  bool empty() const { return m_events.empty(); }
+
+  /// Approximate memory held by the pool
+  std::size_t bytes() const { return m_bytes; }
+
+  const event_type& operator[](std::size_t i) const { return m_events[i]; }
+
+private:
+  std::vector<event_type> m_events;
+  std::size_t m_bytes{0};
+};
+
+} // namespace edm4eic
+
+#endif
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_BOUNDED_QUEUE_HH
+#define EDM4EIC_UTILS_BOUNDED_QUEUE_HH
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace edm4eic {
+
+/** Bounded blocking queue.
+ * A minimal multi-producer, multi-consumer FIFO used to hand frames between
+ * reader, worker and writer threads. Producers block in push() while the
+ * queue holds `capacity` items, which bounds memory use of a pipeline. After
+ * close(), push() fails and pop() drains the remaining items before
+ * returning std::nullopt.
+ */
+template <typename T>
+class bounded_queue {
+public:
+  explicit bounded_queue(std::size_t capacity) : m_capacity{capacity > 0 ? capacity : 1} {}
+
+  bounded_queue(const bounded_queue&) = delete;
+  bounded_queue& operator=(const bounded_queue&) = delete;
+
+  /// Push an item, blocking while full. Returns false if the queue was closed.
+  bool push(T item) {
+    std::unique_lock lock{m_mutex};
+    m_not_full.wait(lock, [this] { return m_closed || m_items.size() < m_capacity; });
+    if (m_closed) {
+      return false;
+    }
+    m_items.push_back(std::move(item));
+    lock.unlock();
+    m_not_empty.notify_one();
+    return true;
+  }
+
+  /// Pop an item, blocking while empty. Returns std::nullopt once closed and drained.
+  std::optional<T> pop() {
+    std::unique_lock lock{m_mutex};
+    m_not_empty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+    if (m_items.empty()) {
+      return std::nullopt;
+    }
+    T item = std::move(m_items.front());
+    m_items.pop_front();
+    lock.unlock();
+    m_not_full.notify_one();
+    return item;
+  }
+
+  /// Stop accepting items and wake up all waiting threads.
+  void close() {
+    {
+      std::lock_guard lock{m_mutex};
+      m_closed = true;
+    }
+    m_not_full.notify_all();
+    m_not_empty.notify_all();
+  }
+
+  bool closed() const {
+    std::lock_guard lock{m_mutex};
+    return m_closed;
+  }
+
+  std::size_t size() const {
+    std::lock_guard lock{m_mutex};
+    return m_items.size();
+  }
+
+  std::size_t capacity() const { return m_capacity; }
+
+private:
+  const std::size_t m_capacity;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_not_full;
+  std::condition_variable m_not_empty;
+  std::deque<T> m_items;
+  bool m_closed{false};
+};
+
+} // namespace edm4eic
+
+#endif
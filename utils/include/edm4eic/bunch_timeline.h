@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_BUNCH_TIMELINE_HH
+#define EDM4EIC_UTILS_BUNCH_TIMELINE_HH
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <edm4eic/unit_system.h>
+
+namespace edm4eic {
+
+/** Event arrival times on a bunch-crossing timeline.
+ * Events of a source with a given rate arrive as a Poisson process. Each
+ * arrival is moved to the next bunch crossing, so several events can share
+ * a crossing. Times are in [ns] from the start of the timeline, and windows
+ * have to be requested in increasing order, which allows arbitrarily long
+ * timelines to be streamed.
+ */
+class bunch_timeline {
+public:
+  /** Construct a timeline.
+   * @param rate          event rate [1/s]
+   * @param bunch_spacing time between bunch crossings [ns], 0 for continuous arrival
+   * @param seed          random seed
+   */
+  bunch_timeline(double rate, double bunch_spacing, uint64_t seed)
+      : m_spacing{bunch_spacing}, m_rng{seed}, m_interval{rate > 0 ? rate / unit::s : 1.} {
+    m_next = rate > 0 ? draw(0) : std::numeric_limits<double>::infinity();
+  }
+
+  /// Arrival times [ns] in [start, end), with start no earlier than any previous end
+  std::vector<double> arrivals(double start, double end) {
+    std::vector<double> times;
+    while (m_next < start) {
+      m_next = draw(m_time);
+    }
+    while (m_next < end) {
+      times.push_back(m_next);
+      m_next = draw(m_time);
+    }
+    return times;
+  }
+
+private:
+  // next arrival after the unsnapped time t
+  double draw(double t) {
+    m_time = t + m_interval(m_rng);
+    return m_spacing > 0 ? std::ceil(m_time / m_spacing) * m_spacing : m_time;
+  }
+
+  double m_spacing;
+  std::mt19937_64 m_rng;
+  std::exponential_distribution<double> m_interval;
+  double m_time{0};
+  double m_next{0};
+};
+
+} // namespace edm4eic
+
+#endif
@@ -0,0 +1,292 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_CELLID_DECODER_HH
+#define EDM4EIC_UTILS_CELLID_DECODER_HH
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <edm4eic/cellid_index.h>
+
+namespace edm4eic {
+
+/// A cellID field with its name
+struct cellid_named_field {
+  std::string_view name;
+  cellid_field field;
+};
+
+namespace detail {
+
+  constexpr std::size_t count_cellid_fields(std::string_view descriptor) {
+    return static_cast<std::size_t>(std::count(descriptor.begin(), descriptor.end(), ',')) + 1;
+  }
+
+  // string_view::find, which not all compilers evaluate on template parameter objects
+  constexpr std::size_t find_cellid_separator(std::string_view s, const char c, std::size_t pos = 0) {
+    for (; pos < s.size(); ++pos) {
+      if (s[pos] == c) {
+        return pos;
+      }
+    }
+    return std::string_view::npos;
+  }
+
+  constexpr int64_t parse_cellid_number(std::string_view s) {
+    const bool negative = !s.empty() && s.front() == '-';
+    if (negative) {
+      s.remove_prefix(1);
+    }
+    if (s.empty()) {
+      throw std::invalid_argument("cellID descriptor: missing number");
+    }
+    int64_t value = 0;
+    for (const char c : s) {
+      if (c < '0' || c > '9') {
+        throw std::invalid_argument("cellID descriptor: invalid number");
+      }
+      value = value * 10 + (c - '0');
+    }
+    return negative ? -value : value;
+  }
+
+  /** Parse one field of a DD4hep descriptor.
+   * Fields are "name:width", starting at `next`, the end of the previous
+   * field, or "name:offset:width"; a negative width marks a signed field.
+   */
+  constexpr cellid_named_field parse_cellid_field(std::string_view item, const unsigned next) {
+    const auto first = find_cellid_separator(item, ':');
+    if (first == std::string_view::npos || first == 0) {
+      throw std::invalid_argument("cellID descriptor: field without name or width");
+    }
+    const auto second = find_cellid_separator(item, ':', first + 1);
+    int64_t offset = next;
+    int64_t width = 0;
+    if (second == std::string_view::npos) {
+      width = parse_cellid_number(item.substr(first + 1));
+    } else {
+      offset = parse_cellid_number(item.substr(first + 1, second - first - 1));
+      width = parse_cellid_number(item.substr(second + 1));
+    }
+    const int64_t bits = width < 0 ? -width : width;
+    if (bits == 0 || offset < 0 || offset + bits > 64) {
+      throw std::invalid_argument("cellID descriptor: field outside of 64 bits");
+    }
+    return {item.substr(0, first), {static_cast<unsigned>(offset), static_cast<unsigned>(bits), width < 0}};
+  }
+
+  /// Parse a descriptor such as "system:8,layer:4,x:32:-16,y:-16" into `out`, calling out(field) for each field
+  template <typename OutputT> constexpr void parse_cellid_descriptor(std::string_view descriptor, OutputT&& out) {
+    unsigned next = 0;
+    while (true) {
+      const auto comma = find_cellid_separator(descriptor, ',');
+      const auto field = parse_cellid_field(descriptor.substr(0, comma), next);
+      out(field);
+      next = field.field.offset + field.field.width;
+      if (comma == std::string_view::npos) {
+        break;
+      }
+      descriptor.remove_prefix(comma + 1);
+    }
+  }
+
+  template <std::size_t N> constexpr std::array<cellid_named_field, N> parse_cellid_descriptor(std::string_view descriptor) {
+    std::array<cellid_named_field, N> fields{};
+    std::size_t i = 0;
+    parse_cellid_descriptor(descriptor, [&fields, &i](const cellid_named_field& field) { fields[i++] = field; });
+    return fields;
+  }
+
+  template <std::size_t N> struct fixed_string {
+    char data[N]{};
+    constexpr fixed_string(const char (&s)[N]) { std::copy_n(s, N, data); }
+    constexpr std::string_view view() const { return {data, N - 1}; }
+  };
+
+  // key that orders fields like their values, for signed fields too
+  constexpr uint64_t cellid_sort_key(const cellid_field& field, const uint64_t cellID) {
+    const uint64_t raw = (cellID & field.mask()) >> field.offset;
+    return field.is_signed ? raw ^ (uint64_t{1} << (field.width - 1)) : raw;
+  }
+
+} // namespace detail
+
+/** cellID decoder for a layout known at compile time.
+ * The descriptor is parsed by the compiler, so that get<"layer">() compiles
+ * to a shift and a mask (and a sign extension for signed fields), without
+ * string lookups or virtual calls. Unknown field names do not compile.
+ *
+ *   using ecal_decoder = cellid_decoder<"system:8,sector:4,layer:6,x:32:-16,y:-16">;
+ *   const int64_t layer = ecal_decoder::get<"layer">(hit.getCellID());
+ */
+template <detail::fixed_string Descriptor> class cellid_decoder {
+public:
+  static constexpr std::size_t size = detail::count_cellid_fields(Descriptor.view());
+  static constexpr std::array<cellid_named_field, size> fields = detail::parse_cellid_descriptor<size>(Descriptor.view());
+
+  static constexpr std::string_view descriptor() { return Descriptor.view(); }
+
+  template <detail::fixed_string Name> static consteval std::size_t index() {
+    for (std::size_t i = 0; i < size; ++i) {
+      if (fields[i].name == Name.view()) {
+        return i;
+      }
+    }
+    throw std::invalid_argument("cellID descriptor: no such field");
+  }
+
+  template <detail::fixed_string Name> static constexpr cellid_field field() { return fields[index<Name>()].field; }
+
+  template <detail::fixed_string Name> static constexpr int64_t get(const uint64_t cellID) {
+    constexpr cellid_field f = field<Name>();
+    return f.get(cellID);
+  }
+
+  template <detail::fixed_string Name> static constexpr std::optional<uint64_t> set(const uint64_t cellID, const int64_t value) {
+    constexpr cellid_field f = field<Name>();
+    return f.set(cellID, value);
+  }
+
+  /// Decode one field of all cellIDs; T has to hold every value of the field
+  template <detail::fixed_string Name, typename T>
+  static void decode(std::span<const uint64_t> cellIDs, std::span<T> out) {
+    constexpr cellid_field f = field<Name>();
+    constexpr auto digits = static_cast<unsigned>(std::numeric_limits<T>::digits);
+    static_assert(std::is_integral_v<T> && (f.is_signed ? std::is_signed_v<T> && f.width <= digits + 1 : f.width <= digits),
+                  "cellid_decoder: field does not fit into the output type");
+    if (out.size() != cellIDs.size()) {
+      throw std::invalid_argument("edm4eic cellid_decoder: inconsistent batch sizes");
+    }
+    for (std::size_t i = 0; i < cellIDs.size(); ++i) {
+      out[i] = static_cast<T>(f.get(cellIDs[i]));
+    }
+  }
+
+  /// Decode all fields of all cellIDs into one column per field
+  static std::array<std::vector<int64_t>, size> decode(std::span<const uint64_t> cellIDs) {
+    std::array<std::vector<int64_t>, size> columns;
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (decode_column<Is>(cellIDs, columns[Is]), ...);
+    }(std::make_index_sequence<size>{});
+    return columns;
+  }
+
+  /** Permutation that sorts cellIDs by the given fields, in this order.
+   * Hits with equal fields keep their order. The fields together must not
+   * be wider than 64 bits.
+   */
+  template <detail::fixed_string... Names> static std::vector<uint32_t> sort_by(std::span<const uint64_t> cellIDs) {
+    static_assert(sizeof...(Names) > 0 && (field<Names>().width + ...) <= 64);
+    std::vector<uint64_t> keys(cellIDs.size());
+    for (std::size_t i = 0; i < cellIDs.size(); ++i) {
+      uint64_t key = 0;
+      ((key = (field<Names>().width < 64 ? key << field<Names>().width : 0) |
+              detail::cellid_sort_key(field<Names>(), cellIDs[i])),
+       ...);
+      keys[i] = key;
+    }
+    std::vector<uint32_t> order(cellIDs.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+    return order;
+  }
+
+private:
+  template <std::size_t I> static void decode_column(std::span<const uint64_t> cellIDs, std::vector<int64_t>& out) {
+    constexpr cellid_field f = fields[I].field;
+    out.resize(cellIDs.size());
+    for (std::size_t i = 0; i < cellIDs.size(); ++i) {
+      out[i] = f.get(cellIDs[i]);
+    }
+  }
+};
+
+/** Decoder of Surface::geometryId and TrackParameters::surface.
+ * These hold an Acts::GeometryIdentifier, documented with the fields from
+ * the most significant bit; descriptors list them from the least.
+ */
+using geometry_id_decoder = cellid_decoder<"extra:8,sensitive:20,approach:8,layer:12,boundary:8,volume:8">;
+
+/** cellID layout known at run time, e.g. from a readout descriptor.
+ * Parsed once and then looked up by name; get the field once outside of
+ * loops over hits.
+ */
+class cellid_layout {
+public:
+  /// Throws std::invalid_argument for malformed descriptors
+  explicit cellid_layout(std::string descriptor) : m_descriptor{std::move(descriptor)} {
+    m_fields.reserve(detail::count_cellid_fields(m_descriptor));
+    // field names refer to the descriptor held here, which is why the layout is not copyable
+    detail::parse_cellid_descriptor(m_descriptor,
+                                    [this](const cellid_named_field& field) { m_fields.push_back(field); });
+  }
+
+  cellid_layout(const cellid_layout&) = delete;
+  cellid_layout& operator=(const cellid_layout&) = delete;
+
+  const std::string& descriptor() const { return m_descriptor; }
+  std::span<const cellid_named_field> fields() const { return m_fields; }
+
+  std::optional<cellid_field> find(std::string_view name) const {
+    const auto it = std::find_if(m_fields.begin(), m_fields.end(), [name](const auto& f) { return f.name == name; });
+    return it != m_fields.end() ? std::optional<cellid_field>{it->field} : std::nullopt;
+  }
+
+  cellid_field field(std::string_view name) const {
+    const auto f = find(name);
+    if (!f) {
+      throw std::out_of_range("edm4eic cellid_layout: no field '" + std::string(name) + "' in " + m_descriptor);
+    }
+    return *f;
+  }
+
+private:
+  std::string m_descriptor;
+  std::vector<cellid_named_field> m_fields;
+};
+
+/** Cache of run-time layouts by descriptor.
+ * Layouts of every detector are parsed once per process; the returned
+ * references stay valid for the lifetime of the cache. Thread-safe.
+ */
+class cellid_layout_cache {
+public:
+  const cellid_layout& get(const std::string& descriptor) {
+    std::lock_guard lock{m_mutex};
+    auto& layout = m_layouts[descriptor];
+    if (!layout) {
+      layout = std::make_unique<cellid_layout>(descriptor);
+    }
+    return *layout;
+  }
+
+  /// Process-wide cache
+  static cellid_layout_cache& instance() {
+    static cellid_layout_cache cache;
+    return cache;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::map<std::string, std::unique_ptr<cellid_layout>, std::less<>> m_layouts;
+};
+
+} // namespace edm4eic
+
+#endif
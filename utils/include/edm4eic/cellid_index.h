@@ -0,0 +1,281 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_CELLID_INDEX_HH
+#define EDM4EIC_UTILS_CELLID_INDEX_HH
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace edm4eic {
+
+/// A bit field of a cellID, as in a DD4hep segmentation ("layer:8:-4" is {8, 4, true} at its offset)
+struct cellid_field {
+  unsigned offset;
+  unsigned width;
+  bool is_signed{false};
+
+  constexpr uint64_t mask() const {
+    return (width >= 64 ? ~uint64_t{0} : ((uint64_t{1} << width) - 1)) << offset;
+  }
+  constexpr int64_t get(const uint64_t cellID) const {
+    if (is_signed) {
+      // move the field to the top, then sign-extend with an arithmetic shift
+      return static_cast<int64_t>(cellID << (64 - offset - width)) >> (64 - width);
+    }
+    return static_cast<int64_t>((cellID & mask()) >> offset);
+  }
+  /// Set the field, or return std::nullopt if the value does not fit
+  constexpr std::optional<uint64_t> set(const uint64_t cellID, const int64_t value) const {
+    if (width < 64) {
+      const int64_t lo = is_signed ? -(int64_t{1} << (width - 1)) : 0;
+      const int64_t hi = is_signed ? (int64_t{1} << (width - 1)) - 1
+                                   : static_cast<int64_t>((uint64_t{1} << width) - 1);
+      if (value < lo || value > hi) {
+        return std::nullopt;
+      }
+    }
+    return (cellID & ~mask()) | ((static_cast<uint64_t>(value) << offset) & mask());
+  }
+};
+
+/** Neighbor-offset descriptor.
+ * The cells adjacent to a cell are reached by adding one of `offsets` to
+ * the given `fields`. Offsets that leave the range of a field are skipped.
+ */
+struct cellid_neighbors {
+  std::vector<cellid_field> fields;
+  std::vector<std::vector<int64_t>> offsets;
+
+  /// All offsets within `distance` in every field (Chebyshev distance), excluding the cell itself
+  static cellid_neighbors grid(std::vector<cellid_field> fields, const int64_t distance = 1) {
+    cellid_neighbors neighbors{std::move(fields), {}};
+    std::vector<int64_t> offset(neighbors.fields.size(), -distance);
+    while (true) {
+      if (std::any_of(offset.begin(), offset.end(), [](int64_t d) { return d != 0; })) {
+        neighbors.offsets.push_back(offset);
+      }
+      std::size_t k = 0;
+      while (k < offset.size() && offset[k] == distance) {
+        offset[k++] = -distance;
+      }
+      if (k == offset.size()) {
+        break;
+      }
+      ++offset[k];
+    }
+    return neighbors;
+  }
+
+  /// Neighbor cellIDs of `cellID`, skipping those out of range of a field
+  template <typename FuncT> void for_each(const uint64_t cellID, FuncT&& func) const {
+    for (const auto& offset : offsets) {
+      std::optional<uint64_t> neighbor{cellID};
+      for (std::size_t k = 0; k < fields.size() && neighbor; ++k) {
+        neighbor = fields[k].set(*neighbor, fields[k].get(*neighbor) + offset[k]);
+      }
+      if (neighbor) {
+        func(*neighbor);
+      }
+    }
+  }
+};
+
+/** Index of the hits of a collection by cellID.
+ * Built once per collection (per frame) from the cellIDs in collection
+ * order. The entries are kept sorted by cellID in one flat array, and an
+ * open-addressing hash table with linear probing maps each distinct cellID
+ * to its first entry, so lookups cost O(1) and touch two cache lines.
+ * Several hits may share a cellID; all of them are returned in collection
+ * order.
+ */
+class cellid_index {
+public:
+  struct entry {
+    uint64_t cellID;
+    uint32_t index;
+  };
+
+  cellid_index() = default;
+
+  explicit cellid_index(std::span<const uint64_t> cellIDs) { build(cellIDs); }
+
+  /// Index a collection, or anything else with getCellID() elements
+  template <typename CollT>
+    requires requires(const CollT& c) { c[0].getCellID(); }
+  explicit cellid_index(const CollT& collection) {
+    std::vector<uint64_t> cellIDs(collection.size());
+    for (std::size_t i = 0; i < cellIDs.size(); ++i) {
+      cellIDs[i] = collection[i].getCellID();
+    }
+    build(cellIDs);
+  }
+
+  std::size_t size() const { return m_entries.size(); }
+  bool empty() const { return m_entries.empty(); }
+
+  /// Index of the first hit in `cellID`, if any
+  std::optional<uint32_t> find(const uint64_t cellID) const {
+    const uint32_t pos = position(cellID);
+    if (pos == empty_slot) {
+      return std::nullopt;
+    }
+    return m_entries[pos].index;
+  }
+
+  bool contains(const uint64_t cellID) const { return position(cellID) != empty_slot; }
+
+  /// All hits in `cellID`
+  std::span<const entry> equal_range(const uint64_t cellID) const {
+    const uint32_t pos = position(cellID);
+    if (pos == empty_slot) {
+      return {};
+    }
+    std::size_t end = pos + 1;
+    while (end < m_entries.size() && m_entries[end].cellID == cellID) {
+      ++end;
+    }
+    return std::span<const entry>{m_entries}.subspan(pos, end - pos);
+  }
+
+  /** Order the entries once more for masked queries with `mask`.
+   * DD4hep readouts keep system, layer and module in the low bits, so the
+   * hits of one layer or module are scattered over the cellID order. This
+   * adds a copy of the entries sorted by (cellID & mask), after which
+   * for_each_masked with the same mask is a binary search, O(log N + matches),
+   * instead of a scan. Costs O(N log N) and 16 bytes per hit for each mask.
+   */
+  void add_mask(const uint64_t mask) {
+    if (is_prefix(mask) || find_masked(mask) != nullptr) {
+      return;
+    }
+    auto& masked = m_masked.emplace_back(mask, m_entries);
+    std::stable_sort(masked.second.begin(), masked.second.end(),
+                     [mask](const entry& a, const entry& b) { return (a.cellID & mask) < (b.cellID & mask); });
+  }
+
+  /** Hits with (cellID & mask) == value, e.g. all hits of one layer.
+   * If the mask covers a contiguous block of the most significant bits, or
+   * was registered with add_mask, the matching entries are contiguous and
+   * found by binary search; otherwise the flat entry array is scanned.
+   * Hits are visited in cellID order.
+   */
+  template <typename FuncT>
+  void for_each_masked(const uint64_t mask, const uint64_t value, FuncT&& func) const {
+    const auto* sorted = is_prefix(mask) ? &m_entries : find_masked(mask);
+    if (sorted != nullptr) {
+      const auto first = std::lower_bound(sorted->begin(), sorted->end(), value & mask,
+                                          [mask](const entry& e, uint64_t v) { return (e.cellID & mask) < v; });
+      for (auto it = first; it != sorted->end() && (it->cellID & mask) == (value & mask); ++it) {
+        func(*it);
+      }
+      return;
+    }
+    for (const auto& e : m_entries) {
+      if ((e.cellID & mask) == (value & mask)) {
+        func(e);
+      }
+    }
+  }
+
+  /// Hits in the neighbor cells of `cellID`
+  template <typename FuncT>
+  void for_each_neighbor(const uint64_t cellID, const cellid_neighbors& neighbors,
+                         FuncT&& func) const {
+    neighbors.for_each(cellID, [&](uint64_t neighbor) {
+      for (const auto& e : equal_range(neighbor)) {
+        func(e);
+      }
+    });
+  }
+
+  /// Sorted entries, grouped by cellID
+  std::span<const entry> entries() const { return m_entries; }
+
+private:
+  static constexpr uint32_t empty_slot = std::numeric_limits<uint32_t>::max();
+
+  // the entries are sorted by cellID, hence also by a mask of leading bits
+  static bool is_prefix(const uint64_t mask) {
+    return mask != 0 && std::countl_one(mask) + std::countr_zero(mask) == 64;
+  }
+
+  const std::vector<entry>* find_masked(const uint64_t mask) const {
+    for (const auto& [m, entries] : m_masked) {
+      if (m == mask) {
+        return &entries;
+      }
+    }
+    return nullptr;
+  }
+
+  // cellIDs differ in a few structured bits, so mix them before masking
+  static uint64_t hash(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+  }
+
+  void build(std::span<const uint64_t> cellIDs) {
+    if (cellIDs.size() >= empty_slot) {
+      throw std::length_error("cellid_index: too many hits");
+    }
+    m_masked.clear();
+    m_entries.resize(cellIDs.size());
+    for (std::size_t i = 0; i < cellIDs.size(); ++i) {
+      m_entries[i] = {cellIDs[i], static_cast<uint32_t>(i)};
+    }
+    std::sort(m_entries.begin(), m_entries.end(), [](const entry& a, const entry& b) {
+      return a.cellID < b.cellID || (a.cellID == b.cellID && a.index < b.index);
+    });
+    // load factor at most 1/2
+    const std::size_t slots = std::bit_ceil(std::max<std::size_t>(2 * m_entries.size(), 8));
+    m_mask = slots - 1;
+    m_slots.assign(slots, empty_slot);
+    for (std::size_t pos = 0; pos < m_entries.size(); ++pos) {
+      if (pos > 0 && m_entries[pos].cellID == m_entries[pos - 1].cellID) {
+        continue;
+      }
+      std::size_t slot = hash(m_entries[pos].cellID) & m_mask;
+      while (m_slots[slot] != empty_slot) {
+        slot = (slot + 1) & m_mask;
+      }
+      m_slots[slot] = static_cast<uint32_t>(pos);
+    }
+  }
+
+  // position of the first entry with `cellID` in m_entries
+  uint32_t position(const uint64_t cellID) const {
+    if (m_slots.empty()) {
+      return empty_slot;
+    }
+    std::size_t slot = hash(cellID) & m_mask;
+    while (m_slots[slot] != empty_slot) {
+      if (m_entries[m_slots[slot]].cellID == cellID) {
+        return m_slots[slot];
+      }
+      slot = (slot + 1) & m_mask;
+    }
+    return empty_slot;
+  }
+
+  std::vector<entry> m_entries;
+  std::vector<std::pair<uint64_t, std::vector<entry>>> m_masked; // entries by (cellID & mask), see add_mask
+  std::vector<uint32_t> m_slots;
+  std::size_t m_mask{0};
+};
+
+} // namespace edm4eic
+
+#endif
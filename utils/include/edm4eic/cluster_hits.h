@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_CLUSTER_HITS_HH
+#define EDM4EIC_UTILS_CLUSTER_HITS_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <edm4eic/CalorimeterHitCollection.h>
+#include <edm4eic/ClusterCollection.h>
+#include <edm4eic/ProtoClusterCollection.h>
+
+#include <edm4eic/hit_columns.h>
+
+namespace edm4eic {
+
+/** Flattened hits of all clusters in a collection.
+ * The hits of cluster i are [offsets[i], offsets[i + 1]) in `hits`, as
+ * indices into one CalorimeterHitCollection, with their weights at the same
+ * positions, so that cluster properties are computed in a streaming pass
+ * over columns (see hit_columns) instead of resolving every relation. A
+ * weight is the fraction of the energy of the hit that is assigned to the
+ * cluster, so weight times hit energy is the energy the hit contributes.
+ */
+struct cluster_hit_index {
+  std::vector<uint32_t> offsets{0};
+  std::vector<uint32_t> hits;
+  std::vector<float> weights;
+
+  std::size_t clusters() const { return offsets.size() - 1; }
+};
+
+namespace detail {
+
+  // `weight(hit, k)` gives the weight of the k-th hit of the cluster
+  template <typename ClusterT, typename WeightT>
+  void add_cluster_hits(cluster_hit_index& index, const ClusterT& cluster, WeightT&& weight,
+                        const CalorimeterHitCollection& hits) {
+    std::size_t k = 0;
+    for (const auto& hit : cluster.getHits()) {
+      const auto id = hit.getObjectID();
+      if (id.collectionID != hits.getID() || id.index < 0 || static_cast<std::size_t>(id.index) >= hits.size()) {
+        throw std::invalid_argument("edm4eic cluster_hits: cluster hit not in the hit collection");
+      }
+      index.hits.push_back(static_cast<uint32_t>(id.index));
+      index.weights.push_back(weight(hit, k));
+      ++k;
+    }
+    index.offsets.push_back(static_cast<uint32_t>(index.hits.size()));
+  }
+
+  inline void check_cluster_sizes(const cluster_hit_index& index, std::size_t hits, std::size_t clusters) {
+    const bool in_range = std::all_of(index.hits.begin(), index.hits.end(), [hits](uint32_t h) { return h < hits; });
+    if (!in_range || index.clusters() != clusters) {
+      throw std::invalid_argument("edm4eic cluster_hits: inconsistent batch sizes");
+    }
+  }
+
+} // namespace detail
+
+/// Flatten proto clusters, with their weights (1 if not filled); all hits must be in `hits`
+inline cluster_hit_index flatten(const ProtoClusterCollection& clusters, const CalorimeterHitCollection& hits) {
+  cluster_hit_index index;
+  index.offsets.reserve(clusters.size() + 1);
+  for (const auto& cluster : clusters) {
+    const auto weights = cluster.getWeights();
+    const bool weighted = weights.size() == cluster.getHits().size();
+    detail::add_cluster_hits(
+        index, cluster, [&](const auto&, std::size_t k) { return weighted ? weights[k] : 1.f; }, hits);
+  }
+  return index;
+}
+
+/** Flatten clusters; all hits must be in `hits`.
+ * The hit contributions of a cluster are energies [GeV], the weights are
+ * the contributions over the energy of their hits, 0 for hits without
+ * energy. Clusters without hit contributions get weight 1 for every hit.
+ */
+inline cluster_hit_index flatten(const ClusterCollection& clusters, const CalorimeterHitCollection& hits) {
+  cluster_hit_index index;
+  index.offsets.reserve(clusters.size() + 1);
+  for (const auto& cluster : clusters) {
+    const auto contributions = cluster.getHitContributions();
+    const bool weighted = contributions.size() == cluster.getHits().size();
+    detail::add_cluster_hits(
+        index, cluster,
+        [&](const auto& hit, std::size_t k) {
+          if (!weighted) {
+            return 1.f;
+          }
+          const float energy = hit.getEnergy();
+          return energy != 0 ? contributions[k] / energy : 0.f;
+        },
+        hits);
+  }
+  return index;
+}
+
+/// Sum of weight times energy of the hits of every cluster, e.g. Cluster::energy
+inline void cluster_energy(const cluster_hit_index& index, std::span<const float> energy, std::span<float> out) {
+  detail::check_cluster_sizes(index, energy.size(), out.size());
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    float sum = 0;
+    for (uint32_t k = index.offsets[i]; k < index.offsets[i + 1]; ++k) {
+      sum += index.weights[k] * energy[index.hits[k]];
+    }
+    out[i] = sum;
+  }
+}
+
+/// Weighting of hit positions in the centroid
+struct centroid_weighting {
+  enum class method { linear, log };
+  method type{method::linear};
+  float log_w0{4.6f}; // log weighting: max(0, w0 + log(E_hit / E_cluster))
+
+  float operator()(float hit_energy, float cluster_energy) const {
+    if (type == method::linear) {
+      return hit_energy;
+    }
+    return hit_energy > 0 && cluster_energy > 0 ? std::max(0.f, log_w0 + std::log(hit_energy / cluster_energy)) : 0.f;
+  }
+};
+
+/** Position and shape of every cluster.
+ * The centroid weights the hit positions by centroid_weighting of weight
+ * times energy; clusters without positive total weight get NaN. The shape
+ * parameters follow the layout of Cluster::shapeParameters: radius (RMS
+ * distance of the hits to the centroid), dispersion (its weighted
+ * counterpart), weighted widths in theta and phi, and weighted widths in
+ * x, y and z.
+ */
+struct cluster_shapes {
+  static constexpr std::size_t parameters = 7;
+
+  std::vector<float> x, y, z;
+  std::vector<float> shape; // clusters x parameters
+
+  explicit cluster_shapes(std::size_t clusters)
+      : x(clusters), y(clusters), z(clusters), shape(clusters * parameters) {}
+
+  std::span<const float> shape_parameters(std::size_t cluster) const {
+    return std::span<const float>{shape}.subspan(cluster * parameters, parameters);
+  }
+};
+
+inline cluster_shapes cluster_shape(const cluster_hit_index& index, std::span<const float> energy,
+                                    std::span<const float> hx, std::span<const float> hy, std::span<const float> hz,
+                                    const centroid_weighting& weighting = {}) {
+  detail::check_cluster_sizes(index, energy.size(), index.clusters());
+  if (hx.size() != energy.size() || hy.size() != energy.size() || hz.size() != energy.size()) {
+    throw std::invalid_argument("edm4eic cluster_hits: inconsistent batch sizes");
+  }
+
+  const std::size_t n = index.clusters();
+  cluster_shapes out{n};
+  std::vector<float> total(n);
+  cluster_energy(index, energy, total);
+  std::vector<float> w(index.hits.size());
+  for (std::size_t i = 0; i < n; ++i) {
+    for (uint32_t k = index.offsets[i]; k < index.offsets[i + 1]; ++k) {
+      w[k] = weighting(index.weights[k] * energy[index.hits[k]], total[i]);
+    }
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const uint32_t begin = index.offsets[i];
+    const uint32_t end = index.offsets[i + 1];
+    double sw = 0, sx = 0, sy = 0, sz = 0;
+    for (uint32_t k = begin; k < end; ++k) {
+      const uint32_t h = index.hits[k];
+      sw += w[k];
+      sx += w[k] * hx[h];
+      sy += w[k] * hy[h];
+      sz += w[k] * hz[h];
+    }
+    auto* shape = out.shape.data() + i * cluster_shapes::parameters;
+    if (!(sw > 0)) {
+      out.x[i] = out.y[i] = out.z[i] = std::numeric_limits<float>::quiet_NaN();
+      std::fill_n(shape, cluster_shapes::parameters, std::numeric_limits<float>::quiet_NaN());
+      continue;
+    }
+    const double cx = sx / sw, cy = sy / sw, cz = sz / sw;
+    const double ctheta = std::atan2(std::hypot(cx, cy), cz);
+    const double cphi = std::atan2(cy, cx);
+
+    double r2 = 0, wr2 = 0, wt2 = 0, wp2 = 0, wx2 = 0, wy2 = 0, wz2 = 0;
+    for (uint32_t k = begin; k < end; ++k) {
+      const uint32_t h = index.hits[k];
+      const double dx = hx[h] - cx, dy = hy[h] - cy, dz = hz[h] - cz;
+      const double d2 = dx * dx + dy * dy + dz * dz;
+      const double dtheta = std::atan2(std::hypot(hx[h], hy[h]), hz[h]) - ctheta;
+      const double dphi = std::remainder(std::atan2(hy[h], hx[h]) - cphi, 2 * std::numbers::pi);
+      r2 += d2;
+      wr2 += w[k] * d2;
+      wt2 += w[k] * dtheta * dtheta;
+      wp2 += w[k] * dphi * dphi;
+      wx2 += w[k] * dx * dx;
+      wy2 += w[k] * dy * dy;
+      wz2 += w[k] * dz * dz;
+    }
+    out.x[i] = static_cast<float>(cx);
+    out.y[i] = static_cast<float>(cy);
+    out.z[i] = static_cast<float>(cz);
+    shape[0] = static_cast<float>(std::sqrt(r2 / (end - begin)));
+    shape[1] = static_cast<float>(std::sqrt(wr2 / sw));
+    shape[2] = static_cast<float>(std::sqrt(wt2 / sw));
+    shape[3] = static_cast<float>(std::sqrt(wp2 / sw));
+    shape[4] = static_cast<float>(std::sqrt(wx2 / sw));
+    shape[5] = static_cast<float>(std::sqrt(wy2 / sw));
+    shape[6] = static_cast<float>(std::sqrt(wz2 / sw));
+  }
+  return out;
+}
+
+inline cluster_shapes cluster_shape(const cluster_hit_index& index, const calorimeter_hit_columns& hits,
+                                    const centroid_weighting& weighting = {}) {
+  return cluster_shape(index, hits.energy(), hits.position_x(), hits.position_y(), hits.position_z(), weighting);
+}
+
+/** Energy of every cluster in each subdetector.
+ * `subdetector` maps every hit to a subdetector in [0, subdetectors), e.g.
+ * from a cellID field; `out` holds clusters x subdetectors energies, as in
+ * Cluster::subdetectorEnergies.
+ */
+inline void subdetector_energies(const cluster_hit_index& index, std::span<const float> energy,
+                                 std::span<const uint32_t> subdetector, std::size_t subdetectors,
+                                 std::span<float> out) {
+  detail::check_cluster_sizes(index, energy.size(), out.size() / std::max<std::size_t>(subdetectors, 1));
+  if (subdetector.size() != energy.size() || out.size() != index.clusters() * subdetectors) {
+    throw std::invalid_argument("edm4eic cluster_hits: inconsistent batch sizes");
+  }
+  std::fill(out.begin(), out.end(), 0.f);
+  for (std::size_t i = 0; i < index.clusters(); ++i) {
+    auto* sums = out.data() + i * subdetectors;
+    for (uint32_t k = index.offsets[i]; k < index.offsets[i + 1]; ++k) {
+      const uint32_t h = index.hits[k];
+      if (subdetector[h] >= subdetectors) {
+        throw std::out_of_range("edm4eic cluster_hits: subdetector out of range");
+      }
+      sums[subdetector[h]] += index.weights[k] * energy[h];
+    }
+  }
+}
+
+} // namespace edm4eic
+
+#endif
@@ -0,0 +1,321 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_COLLECTION_POOL_HH
+#define EDM4EIC_UTILS_COLLECTION_POOL_HH
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <podio/CollectionBase.h>
+#include <podio/CollectionBufferFactory.h>
+#include <podio/CollectionBuffers.h>
+#include <podio/CollectionIDTable.h>
+#include <podio/Frame.h>
+#include <podio/ObjectID.h>
+
+#include <edm4eic/ClusterCollection.h>
+#include <edm4eic/RawCALOROCHitCollection.h>
+#include <edm4eic/TensorCollection.h>
+
+#include <edm4eic/frame_splice.h>
+
+namespace edm4eic {
+
+/** Recycled output collections.
+ * Hands out the collections of an output frame that is kept from event to
+ * event instead of being destroyed after writing: recycle() clears every
+ * collection, which keeps the capacity of its buffers, so after the largest
+ * event so far (the high-water mark) no collection buffer is reallocated.
+ * Only those buffers are recycled, not the objects: every create() still
+ * heap-allocates one object, plus the vectors of its VectorMembers and
+ * OneToManyRelations as they are filled. Output built as data structs
+ * avoids these allocations with a collection_arena instead.
+ * The frame is written with e.g. writer.writeFrame(pool.frame(), "events").
+ *
+ *   collection_pool pool;
+ *   for (...) {
+ *     auto& hits = pool.get<edm4eic::RawTrackerHitCollection>("RawTrackerHits");
+ *     ... fill hits ...
+ *     writer.writeFrame(pool.frame(), "events");
+ *     pool.recycle();
+ *   }
+ *
+ * The collections are owned by the frame, but get() keeps changing them
+ * after Frame::put: whatever is taken from pool.frame() or from these
+ * collections, objects included, is only valid until recycle().
+ * Every event must use the same collections. Frame parameters cannot be
+ * removed, so parameters have to be set again in every event. With
+ * `trim_after`, the frame is dropped, and its memory released, after that
+ * many consecutive events below a quarter of the high-water mark.
+ * Not thread-safe; use one pool per thread.
+ */
+class collection_pool {
+public:
+  explicit collection_pool(std::size_t trim_after = 0) : m_trim_after{trim_after} {}
+
+  collection_pool(const collection_pool&) = delete;
+  collection_pool& operator=(const collection_pool&) = delete;
+
+  /// Collection `name` of the current event, put into the frame on first use
+  template <typename CollT> CollT& get(const std::string& name) {
+    const auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const auto& e) { return e.name == name; });
+    if (it != m_entries.end()) {
+      auto* collection = dynamic_cast<CollT*>(it->collection);
+      if (collection == nullptr) {
+        throw std::invalid_argument("collection_pool: collection " + name + " has a different type");
+      }
+      return *collection;
+    }
+    if (!m_frame) {
+      m_frame.emplace();
+    }
+    // Frame::put returns the collection as const, since a frame is not meant to change after it is filled, but
+    // the collection it owns is not const. It is only changed between writeFrame() and recycle(), and clear()
+    // resets its prepared write buffers, so that every writeFrame() writes the collection as filled in that event.
+    auto& collection = const_cast<CollT&>(m_frame->put(CollT{}, name));
+    m_entries.push_back({name, &collection, 0});
+    return collection;
+  }
+
+  /// Output frame of the current event
+  podio::Frame& frame() {
+    if (!m_frame) {
+      m_frame.emplace();
+    }
+    return *m_frame;
+  }
+
+  /// Clear all collections for the next event, keeping their capacity
+  void recycle() {
+    bool small = !m_entries.empty();
+    for (auto& entry : m_entries) {
+      const std::size_t size = entry.collection->size();
+      entry.high_water = std::max(entry.high_water, size);
+      small = small && size < entry.high_water / 4;
+      entry.collection->clear();
+    }
+    m_small_events = small ? m_small_events + 1 : 0;
+    if (m_trim_after > 0 && m_small_events >= m_trim_after) {
+      trim();
+    }
+  }
+
+  /// Drop the frame and all collections, releasing their memory
+  void trim() {
+    m_entries.clear();
+    m_frame.reset();
+    m_small_events = 0;
+  }
+
+  /// Largest size of a collection since it was created
+  std::size_t high_water_mark(const std::string& name) const {
+    const auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const auto& e) { return e.name == name; });
+    return it != m_entries.end() ? std::max(it->high_water, it->collection->size()) : 0;
+  }
+
+private:
+  struct entry {
+    std::string name;
+    podio::CollectionBase* collection;
+    std::size_t high_water;
+  };
+
+  std::optional<podio::Frame> m_frame;
+  std::vector<entry> m_entries;
+  std::size_t m_trim_after;
+  std::size_t m_small_events{0};
+};
+
+/** Arena traits.
+ * The [begin, end) ranges of a podio data struct into the OneToManyRelation
+ * and VectorMember buffers of its collection, in the order of the buffers,
+ * for datatypes without OneToOneRelations.
+ */
+template <typename DataT> struct arena_traits;
+
+template <> struct arena_traits<edm4eic::TensorData> {
+  using data_type = edm4eic::TensorData;
+  using vector_members = std::tuple<int64_t, float, int64_t>;
+  static constexpr std::array<std::pair<unsigned data_type::*, unsigned data_type::*>, 0> relations{};
+  static constexpr std::array<std::pair<unsigned data_type::*, unsigned data_type::*>, 3> vectors{{
+      {&data_type::shape_begin, &data_type::shape_end},
+      {&data_type::floatData_begin, &data_type::floatData_end},
+      {&data_type::int64Data_begin, &data_type::int64Data_end},
+  }};
+};
+
+template <> struct arena_traits<edm4eic::RawCALOROCHitData> {
+  using data_type = edm4eic::RawCALOROCHitData;
+  using vector_members = std::tuple<edm4eic::CALOROC1ASample, edm4eic::CALOROC1BSample>;
+  static constexpr std::array<std::pair<unsigned data_type::*, unsigned data_type::*>, 0> relations{};
+  static constexpr std::array<std::pair<unsigned data_type::*, unsigned data_type::*>, 2> vectors{{
+      {&data_type::aSamples_begin, &data_type::aSamples_end},
+      {&data_type::bSamples_begin, &data_type::bSamples_end},
+  }};
+};
+
+template <> struct arena_traits<edm4eic::ClusterData> {
+  using data_type = edm4eic::ClusterData;
+  using vector_members = std::tuple<float, float, float>;
+  static constexpr std::array<std::pair<unsigned data_type::*, unsigned data_type::*>, 3> relations{{
+      {&data_type::clusters_begin, &data_type::clusters_end},
+      {&data_type::hits_begin, &data_type::hits_end},
+      {&data_type::particleIDs_begin, &data_type::particleIDs_end},
+  }};
+  static constexpr std::array<std::pair<unsigned data_type::*, unsigned data_type::*>, 3> vectors{{
+      {&data_type::shapeParameters_begin, &data_type::shapeParameters_end},
+      {&data_type::hitContributions_begin, &data_type::hitContributions_end},
+      {&data_type::subdetectorEnergies_begin, &data_type::subdetectorEnergies_end},
+  }};
+};
+
+/** Collection built directly in its I/O buffers.
+ * Objects are appended as data structs, and their VectorMembers and
+ * relations are appended to the concatenated buffers of the collection, an
+ * arena per member, instead of to one std::vector per object. release()
+ * hands the buffers to a frame_buffers (and from there to a podio::Frame)
+ * and starts new buffers, reserved to the high-water mark of every buffer,
+ * so that each buffer is allocated once per event.
+ *
+ *   collection_arena<edm4eic::ClusterCollection, edm4eic::ClusterData> clusters{"EcalClusters"};
+ *   const auto id = clusters.push_back(data);
+ *   clusters.add_vector_member<1>(contributions); // hitContributions of the last cluster
+ *   clusters.add_relation(1, hit.getObjectID());  // hits of the last cluster
+ *   clusters.release(event_buffers);
+ *
+ * VectorMembers and relations are added to the last object only.
+ */
+template <typename CollT, typename DataT> class collection_arena {
+public:
+  using traits = arena_traits<DataT>;
+  static constexpr std::size_t n_relations = traits::relations.size();
+  static constexpr std::size_t n_vector_members = std::tuple_size_v<typename traits::vector_members>;
+  template <std::size_t I> using vector_member_type = std::tuple_element_t<I, typename traits::vector_members>;
+
+  explicit collection_arena(std::string name)
+      : m_name{std::move(name)}, m_id{podio::CollectionIDTable{}.add(m_name)}, m_buffers{create()} {}
+
+  collection_arena(const collection_arena&) = delete;
+  collection_arena& operator=(const collection_arena&) = delete;
+
+  ~collection_arena() {
+    if (m_buffers.deleteBuffers) {
+      m_buffers.deleteBuffers(m_buffers);
+    }
+  }
+
+  const std::string& name() const { return m_name; }
+  /// ID of the collection in the frame, for relations to its objects
+  uint32_t collectionID() const { return m_id; }
+  std::size_t size() const { return data().size(); }
+
+  /// Append an object, with empty VectorMembers and relations; returns its ID
+  podio::ObjectID push_back(DataT object) {
+    for (std::size_t k = 0; k < n_relations; ++k) {
+      const auto begin = static_cast<unsigned>((*m_buffers.references)[k]->size());
+      object.*traits::relations[k].first = begin;
+      object.*traits::relations[k].second = begin;
+    }
+    set_vector_ranges(object, std::make_index_sequence<n_vector_members>{});
+    data().push_back(object);
+    return {static_cast<int>(data().size() - 1), m_id};
+  }
+
+  DataT& back() { return data().back(); }
+
+  /// Append values to VectorMember I of the last object
+  template <std::size_t I> void add_vector_member(std::span<const vector_member_type<I>> values) {
+    auto* vec = detail::vector_member<vector_member_type<I>>(m_buffers, I);
+    vec->insert(vec->end(), values.begin(), values.end());
+    back().*traits::vectors[I].second = static_cast<unsigned>(vec->size());
+  }
+
+  template <std::size_t I> void add_vector_member(const vector_member_type<I>& value) {
+    add_vector_member<I>(std::span<const vector_member_type<I>>{&value, 1});
+  }
+
+  /// Append a related object to OneToManyRelation k of the last object
+  void add_relation(std::size_t k, podio::ObjectID id) {
+    auto& refs = *(*m_buffers.references)[k];
+    refs.push_back(id);
+    back().*traits::relations[k].second = static_cast<unsigned>(refs.size());
+  }
+
+  /// Hand the collection to `frame` and start an empty one
+  void release(frame_buffers& frame) { frame.put(m_name, m_id, release()); }
+
+  /// Take the buffers of the collection and start an empty one; the caller owns the buffers
+  podio::CollectionReadBuffers release() {
+    update_high_water();
+    auto buffers = std::exchange(m_buffers, create());
+    data().reserve(m_high_water[0]);
+    for (std::size_t k = 0; k < n_relations; ++k) {
+      (*m_buffers.references)[k]->reserve(m_high_water[1 + k]);
+    }
+    reserve_vector_members(std::make_index_sequence<n_vector_members>{});
+    return buffers;
+  }
+
+  /// Largest number of objects in the collection
+  std::size_t high_water_mark() const { return std::max(m_high_water[0], size()); }
+
+private:
+  static podio::CollectionReadBuffers create() {
+    auto buffers = podio::CollectionBufferFactory::instance().createBuffers(std::string(CollT::typeName),
+                                                                             CollT{}.getSchemaVersion(), false);
+    if (!buffers) {
+      throw std::runtime_error("collection_arena: no buffers for " + std::string(CollT::typeName));
+    }
+    return std::move(*buffers);
+  }
+
+  std::vector<DataT>& data() { return *static_cast<std::vector<DataT>*>(m_buffers.data); }
+  const std::vector<DataT>& data() const { return *static_cast<const std::vector<DataT>*>(m_buffers.data); }
+
+  template <std::size_t... Is> void set_vector_ranges(DataT& object, std::index_sequence<Is...>) {
+    (
+        [&] {
+          const auto begin = static_cast<unsigned>(detail::vector_member<vector_member_type<Is>>(m_buffers, Is)->size());
+          object.*traits::vectors[Is].first = begin;
+          object.*traits::vectors[Is].second = begin;
+        }(),
+        ...);
+  }
+
+  void update_high_water() {
+    m_high_water[0] = std::max(m_high_water[0], data().size());
+    for (std::size_t k = 0; k < n_relations; ++k) {
+      m_high_water[1 + k] = std::max(m_high_water[1 + k], (*m_buffers.references)[k]->size());
+    }
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      ((m_high_water[1 + n_relations + Is] =
+            std::max(m_high_water[1 + n_relations + Is],
+                     detail::vector_member<vector_member_type<Is>>(m_buffers, Is)->size())),
+       ...);
+    }(std::make_index_sequence<n_vector_members>{});
+  }
+
+  template <std::size_t... Is> void reserve_vector_members(std::index_sequence<Is...>) {
+    (detail::vector_member<vector_member_type<Is>>(m_buffers, Is)->reserve(m_high_water[1 + n_relations + Is]), ...);
+  }
+
+  std::string m_name;
+  uint32_t m_id;
+  podio::CollectionReadBuffers m_buffers;
+  // objects, then every relation buffer, then every VectorMember buffer
+  std::array<std::size_t, 1 + n_relations + n_vector_members> m_high_water{};
+};
+
+} // namespace edm4eic
+
+#endif
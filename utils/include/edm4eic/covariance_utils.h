@@ -0,0 +1,462 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_COVARIANCE_HH
+#define EDM4EIC_UTILS_COVARIANCE_HH
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include <edm4eic/Cov2f.h>
+#include <edm4eic/Cov3f.h>
+#include <edm4eic/Cov4f.h>
+#include <edm4eic/Cov6f.h>
+#include <edm4eic/Surface.h>
+#include <edm4eic/TrackParametersCollection.h>
+
+namespace edm4eic {
+
+/// Dense row-major matrix in double precision
+template <std::size_t R, std::size_t C> using dense_matrix = std::array<double, R * C>;
+
+/** Packed layout of the covariance components.
+ * `index[i][j]` is the position of element (i, j) in the packed float
+ * storage, resolved at compile time instead of on every access as in the
+ * generated operator()(i, j).
+ */
+template <typename CovT> struct cov_traits;
+
+namespace detail {
+
+template <std::size_t N, std::size_t P>
+constexpr std::array<std::array<uint8_t, N>, N>
+cov_index_table(const std::array<std::array<uint8_t, 2>, P>& offdiagonal) {
+  std::array<std::array<uint8_t, N>, N> index{};
+  for (std::size_t i = 0; i < N; ++i) {
+    index[i][i] = static_cast<uint8_t>(i);
+  }
+  for (std::size_t k = 0; k < P; ++k) {
+    const auto [i, j] = offdiagonal[k];
+    index[i][j] = index[j][i] = static_cast<uint8_t>(N + k);
+  }
+  return index;
+}
+
+// triangular packing of Cov6f, (i, j) with i <= j at i + j(j+1)/2
+template <std::size_t N> constexpr std::array<std::array<uint8_t, N>, N> cov_index_triangular() {
+  std::array<std::array<uint8_t, N>, N> index{};
+  for (std::size_t j = 0; j < N; ++j) {
+    for (std::size_t i = 0; i <= j; ++i) {
+      index[i][j] = index[j][i] = static_cast<uint8_t>(i + j * (j + 1) / 2);
+    }
+  }
+  return index;
+}
+
+} // namespace detail
+
+template <> struct cov_traits<Cov2f> {
+  static constexpr std::size_t dim = 2;
+  static constexpr auto index = detail::cov_index_table<2, 1>({{{0, 1}}});
+  static const float* data(const Cov2f& c) { return &c.xx; }
+  static float* data(Cov2f& c) { return &c.xx; }
+};
+template <> struct cov_traits<Cov3f> {
+  static constexpr std::size_t dim = 3;
+  static constexpr auto index = detail::cov_index_table<3, 3>({{{0, 1}, {0, 2}, {1, 2}}});
+  static const float* data(const Cov3f& c) { return &c.xx; }
+  static float* data(Cov3f& c) { return &c.xx; }
+};
+template <> struct cov_traits<Cov4f> {
+  static constexpr std::size_t dim = 4;
+  static constexpr auto index =
+      detail::cov_index_table<4, 6>({{{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}}});
+  static const float* data(const Cov4f& c) { return &c.xx; }
+  static float* data(Cov4f& c) { return &c.xx; }
+};
+template <> struct cov_traits<Cov6f> {
+  static constexpr std::size_t dim = 6;
+  static constexpr auto index = detail::cov_index_triangular<6>();
+  static const float* data(const Cov6f& c) { return c.covariance.data(); }
+  static float* data(Cov6f& c) { return c.covariance.data(); }
+};
+
+template <typename CovT>
+concept PackedCovariance = requires { cov_traits<CovT>::dim; };
+
+/// Expand a packed covariance into a dense symmetric matrix
+template <PackedCovariance CovT> auto unpack(const CovT& cov) {
+  using traits = cov_traits<CovT>;
+  constexpr std::size_t N = traits::dim;
+  const float* packed = traits::data(cov);
+  dense_matrix<N, N> m;
+  for (std::size_t i = 0; i < N; ++i) {
+    for (std::size_t j = 0; j < N; ++j) {
+      m[i * N + j] = packed[traits::index[i][j]];
+    }
+  }
+  return m;
+}
+
+/// Pack the upper triangle of a dense symmetric matrix
+template <PackedCovariance CovT>
+CovT pack(const dense_matrix<cov_traits<CovT>::dim, cov_traits<CovT>::dim>& m) {
+  using traits = cov_traits<CovT>;
+  constexpr std::size_t N = traits::dim;
+  CovT cov;
+  float* packed = traits::data(cov);
+  for (std::size_t i = 0; i < N; ++i) {
+    for (std::size_t j = i; j < N; ++j) {
+      packed[traits::index[i][j]] = static_cast<float>(m[i * N + j]);
+    }
+  }
+  return cov;
+}
+
+/** Similarity transform J C J^T.
+ * J maps the N parameters of `cov` to the parameters of CovOut, whose
+ * dimension M fixes the shape M x N of J.
+ */
+template <PackedCovariance CovOut, PackedCovariance CovIn>
+CovOut similarity(const dense_matrix<cov_traits<CovOut>::dim, cov_traits<CovIn>::dim>& J,
+                  const CovIn& cov) {
+  constexpr std::size_t M = cov_traits<CovOut>::dim;
+  constexpr std::size_t N = cov_traits<CovIn>::dim;
+  const auto C = unpack(cov);
+  dense_matrix<M, N> JC{};
+  for (std::size_t i = 0; i < M; ++i) {
+    for (std::size_t k = 0; k < N; ++k) {
+      const double a = J[i * N + k];
+      for (std::size_t j = 0; j < N; ++j) {
+        JC[i * N + j] += a * C[k * N + j];
+      }
+    }
+  }
+  dense_matrix<M, M> out{};
+  for (std::size_t i = 0; i < M; ++i) {
+    for (std::size_t j = i; j < M; ++j) {
+      double sum = 0;
+      for (std::size_t k = 0; k < N; ++k) {
+        sum += JC[i * N + k] * J[j * N + k];
+      }
+      out[i * M + j] = out[j * M + i] = sum;
+    }
+  }
+  return pack<CovOut>(out);
+}
+
+/** Cholesky decomposition C = L L^T.
+ * Returns the lower triangle L (upper triangle zero), or std::nullopt if the
+ * covariance is not positive definite.
+ */
+template <PackedCovariance CovT> auto cholesky(const CovT& cov) {
+  constexpr std::size_t N = cov_traits<CovT>::dim;
+  const auto C = unpack(cov);
+  std::optional<dense_matrix<N, N>> result{std::in_place};
+  auto& L = *result;
+  L.fill(0);
+  for (std::size_t j = 0; j < N; ++j) {
+    double d = C[j * N + j];
+    for (std::size_t k = 0; k < j; ++k) {
+      d -= L[j * N + k] * L[j * N + k];
+    }
+    if (!(d > 0)) {
+      result.reset();
+      return result;
+    }
+    L[j * N + j] = std::sqrt(d);
+    for (std::size_t i = j + 1; i < N; ++i) {
+      double s = C[i * N + j];
+      for (std::size_t k = 0; k < j; ++k) {
+        s -= L[i * N + k] * L[j * N + k];
+      }
+      L[i * N + j] = s / L[j * N + j];
+    }
+  }
+  return result;
+}
+
+/// Inverse of a positive definite covariance, std::nullopt if singular
+template <PackedCovariance CovT> std::optional<CovT> invert(const CovT& cov) {
+  constexpr std::size_t N = cov_traits<CovT>::dim;
+  const auto L = cholesky(cov);
+  if (!L) {
+    return std::nullopt;
+  }
+  // L^-1 by forward substitution, then C^-1 = L^-T L^-1
+  dense_matrix<N, N> Linv{};
+  for (std::size_t j = 0; j < N; ++j) {
+    Linv[j * N + j] = 1. / (*L)[j * N + j];
+    for (std::size_t i = j + 1; i < N; ++i) {
+      double s = 0;
+      for (std::size_t k = j; k < i; ++k) {
+        s -= (*L)[i * N + k] * Linv[k * N + j];
+      }
+      Linv[i * N + j] = s / (*L)[i * N + i];
+    }
+  }
+  dense_matrix<N, N> inv{};
+  for (std::size_t i = 0; i < N; ++i) {
+    for (std::size_t j = i; j < N; ++j) {
+      double s = 0;
+      for (std::size_t k = j; k < N; ++k) {
+        s += Linv[k * N + i] * Linv[k * N + j];
+      }
+      inv[i * N + j] = inv[j * N + i] = s;
+    }
+  }
+  return pack<CovT>(inv);
+}
+
+/** Chi-squared r^T C^-1 r of a residual.
+ * Evaluated through the Cholesky factor without forming the inverse. Returns
+ * NaN if the covariance is not positive definite.
+ */
+template <PackedCovariance CovT>
+double chi2(const std::array<double, cov_traits<CovT>::dim>& residual, const CovT& cov) {
+  constexpr std::size_t N = cov_traits<CovT>::dim;
+  const auto L = cholesky(cov);
+  if (!L) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  std::array<double, N> y;
+  double sum = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    double s = residual[i];
+    for (std::size_t k = 0; k < i; ++k) {
+      s -= (*L)[i * N + k] * y[k];
+    }
+    y[i] = s / (*L)[i * N + i];
+    sum += y[i] * y[i];
+  }
+  return sum;
+}
+
+/** Surface of bound track parameters.
+ * The local frame of bound parameters depends on the surface type, with the
+ * encoding of edm4eic::Surface::surfaceType. Supported are
+ *  - plane and curvilinear surfaces, whose local axes l0 and l1 are the first
+ *    two columns of the rotation,
+ *  - perigee and straw (line) surfaces, whose line axis is the third column
+ *    of the rotation; l1 is along the line and l0 the signed distance along
+ *    line x direction, so the global position depends on the direction.
+ * The Jacobians below throw std::invalid_argument for any other type (cone,
+ * cylinder, disc), whose local coordinates are not linear in the position.
+ */
+struct bound_surface {
+  static constexpr int cone = 0, cylinder = 1, disc = 2, perigee = 3, plane = 4, straw = 5, curvilinear = 6;
+
+  int type{plane};
+  std::array<double, 9> rotation{1, 0, 0, 0, 1, 0, 0, 0, 1}; // row-major global rotation
+
+  /// Type and rotation of a surface, e.g. from a surface_table
+  static bound_surface from(const edm4eic::Surface& surface) {
+    const auto& t = surface.transform; // row-wise 4x4 [R T; 0 1]
+    return {surface.surfaceType, {t[0], t[1], t[2], t[4], t[5], t[6], t[8], t[9], t[10]}};
+  }
+
+  bool is_line() const { return type == perigee || type == straw; }
+};
+
+namespace detail {
+
+// d(position)/d(l0, l1, theta, phi) of bound parameters, row-major 3 x 4
+inline std::array<double, 12> bound_position_jacobian(const double st, const double ct, const double sp,
+                                                      const double cp, const float loc0,
+                                                      const bound_surface& surface) {
+  const auto& R = surface.rotation;
+  std::array<double, 12> J{};
+  if (surface.type == bound_surface::plane || surface.type == bound_surface::curvilinear) {
+    for (std::size_t i = 0; i < 3; ++i) {
+      J[i * 4 + 0] = R[i * 3 + 0];
+      J[i * 4 + 1] = R[i * 3 + 1];
+    }
+    return J;
+  }
+  if (!surface.is_line()) {
+    throw std::invalid_argument("edm4eic covariance_utils: bound parameters on surface type " +
+                                std::to_string(surface.type) + " are not supported");
+  }
+  // x = c + l1 a + l0 n with n = (a x d) / |a x d|, so x moves with the direction d
+  const std::array<double, 3> a{R[2], R[5], R[8]};
+  const std::array<double, 3> d{st * cp, st * sp, ct};
+  const auto cross = [](const std::array<double, 3>& u, const std::array<double, 3>& v) {
+    return std::array<double, 3>{u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+  };
+  auto n = cross(a, d);
+  const double norm = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+  if (!(norm > 0)) {
+    throw std::invalid_argument("edm4eic covariance_utils: direction along the line surface");
+  }
+  for (auto& x : n) {
+    x /= norm;
+  }
+  // dn/dalpha = (1 - n n^T) (a x dd/dalpha) / |a x d|
+  const std::array<std::array<double, 3>, 2> dd{{{ct * cp, ct * sp, -st}, {-st * sp, st * cp, 0}}};
+  for (std::size_t i = 0; i < 3; ++i) {
+    J[i * 4 + 0] = n[i];
+    J[i * 4 + 1] = a[i];
+  }
+  for (std::size_t k = 0; k < 2; ++k) {
+    const auto u = cross(a, dd[k]);
+    const double un = u[0] * n[0] + u[1] * n[1] + u[2] * n[2];
+    for (std::size_t i = 0; i < 3; ++i) {
+      J[i * 4 + 2 + k] = loc0 * (u[i] - un * n[i]) / norm;
+    }
+  }
+  return J;
+}
+
+} // namespace detail
+
+/** Jacobian from bound to free track parameters.
+ * Bound parameters are [l0, l1, theta, phi, q/p, t] on `surface`; free
+ * parameters are [x, y, z, t, dx, dy, dz, q/p] with a unit direction. `loc0`
+ * is only used for line surfaces.
+ */
+inline dense_matrix<8, 6> bound_to_free_jacobian(const float theta, const float phi, const float loc0,
+                                                 const bound_surface& surface) {
+  const double st = std::sin(theta), ct = std::cos(theta);
+  const double sp = std::sin(phi), cp = std::cos(phi);
+  const auto position = detail::bound_position_jacobian(st, ct, sp, cp, loc0, surface);
+  dense_matrix<8, 6> J{};
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t k = 0; k < 4; ++k) {
+      J[i * 6 + k] = position[i * 4 + k];
+    }
+  }
+  J[3 * 6 + 5] = 1;
+  J[4 * 6 + 2] = ct * cp;
+  J[4 * 6 + 3] = -st * sp;
+  J[5 * 6 + 2] = ct * sp;
+  J[5 * 6 + 3] = st * cp;
+  J[6 * 6 + 2] = -st;
+  J[7 * 6 + 4] = 1;
+  return J;
+}
+
+/// Free covariance [x, y, z, t, dx, dy, dz, q/p] of bound track parameters
+inline dense_matrix<8, 8> bound_to_free(const edm4eic::TrackParameters& params, const bound_surface& surface) {
+  const auto J = bound_to_free_jacobian(params.getTheta(), params.getPhi(), params.getLoc().a, surface);
+  const auto C = unpack(params.getCovariance());
+  dense_matrix<8, 8> out{};
+  for (std::size_t i = 0; i < 8; ++i) {
+    for (std::size_t j = i; j < 8; ++j) {
+      double sum = 0;
+      for (std::size_t k = 0; k < 6; ++k) {
+        for (std::size_t l = 0; l < 6; ++l) {
+          sum += J[i * 6 + k] * C[k * 6 + l] * J[j * 6 + l];
+        }
+      }
+      out[i * 8 + j] = out[j * 8 + i] = sum;
+    }
+  }
+  return out;
+}
+
+/** Jacobian from bound parameters to [x, y, z, px, py, pz].
+ * The basis of Track.positionMomentumCovariance; the time column is dropped.
+ * Tracks with |qOverP| < 1e-9 have zero momentum, as in momenta_from_tracking:
+ * their momentum rows are zero, and so is the momentum block of the
+ * covariance.
+ */
+inline dense_matrix<6, 6> bound_to_position_momentum_jacobian(const float theta, const float phi,
+                                                              const float qOverP, const float loc0,
+                                                              const bound_surface& surface) {
+  const double st = std::sin(theta), ct = std::cos(theta);
+  const double sp = std::sin(phi), cp = std::cos(phi);
+  const bool no_momentum = std::fabs(qOverP) < 1e-9;
+  const double p = no_momentum ? 0. : 1. / std::fabs(qOverP);
+  const double dp = no_momentum ? 0. : -p / qOverP; // d|p|/d(q/p)
+  const auto position = detail::bound_position_jacobian(st, ct, sp, cp, loc0, surface);
+  dense_matrix<6, 6> J{};
+  for (std::size_t i = 0; i < 3; ++i) {
+    for (std::size_t k = 0; k < 4; ++k) {
+      J[i * 6 + k] = position[i * 4 + k];
+    }
+  }
+  J[3 * 6 + 2] = p * ct * cp;
+  J[3 * 6 + 3] = -p * st * sp;
+  J[3 * 6 + 4] = dp * st * cp;
+  J[4 * 6 + 2] = p * ct * sp;
+  J[4 * 6 + 3] = p * st * cp;
+  J[4 * 6 + 4] = dp * st * sp;
+  J[5 * 6 + 2] = -p * st;
+  J[5 * 6 + 4] = dp * ct;
+  return J;
+}
+
+/// Covariance in the basis of Track.positionMomentumCovariance
+inline Cov6f bound_to_position_momentum(const edm4eic::TrackParameters& params, const bound_surface& surface) {
+  return similarity<Cov6f>(bound_to_position_momentum_jacobian(params.getTheta(), params.getPhi(),
+                                                               params.getQOverP(), params.getLoc().a, surface),
+                           params.getCovariance());
+}
+
+// Batch versions over whole collections or spans of covariances
+
+/// J_i C_i J_i^T for every element
+template <PackedCovariance CovOut, PackedCovariance CovIn>
+void similarity(
+    std::span<const dense_matrix<cov_traits<CovOut>::dim, cov_traits<CovIn>::dim>> J,
+    std::span<const CovIn> cov, std::span<CovOut> out) {
+  if (J.size() != cov.size() || out.size() != cov.size()) {
+    throw std::invalid_argument("edm4eic covariance similarity: inconsistent batch sizes");
+  }
+  for (std::size_t i = 0; i < cov.size(); ++i) {
+    out[i] = similarity<CovOut>(J[i], cov[i]);
+  }
+}
+
+/// Inverse of every covariance; returns the number of singular ones, which are zeroed
+template <PackedCovariance CovT> std::size_t invert(std::span<const CovT> cov, std::span<CovT> out) {
+  if (out.size() != cov.size()) {
+    throw std::invalid_argument("edm4eic covariance invert: inconsistent batch sizes");
+  }
+  std::size_t singular = 0;
+  for (std::size_t i = 0; i < cov.size(); ++i) {
+    const auto inv = invert(cov[i]);
+    singular += inv ? 0 : 1;
+    out[i] = inv.value_or(CovT{});
+  }
+  return singular;
+}
+
+/// Chi-squared of every residual, NaN where the covariance is not positive definite
+template <PackedCovariance CovT>
+void chi2(std::span<const std::array<double, cov_traits<CovT>::dim>> residuals,
+          std::span<const CovT> cov, std::span<double> out) {
+  if (residuals.size() != cov.size() || out.size() != cov.size()) {
+    throw std::invalid_argument("edm4eic covariance chi2: inconsistent batch sizes");
+  }
+  for (std::size_t i = 0; i < cov.size(); ++i) {
+    out[i] = chi2(residuals[i], cov[i]);
+  }
+}
+
+/** Position-momentum covariances of a TrackParametersCollection.
+ * `surface(id)` returns the bound_surface of the surface with the given
+ * geometry id, e.g. bound_surface::from on a surface_table entry.
+ */
+template <typename SurfaceT>
+void bound_to_position_momentum(const edm4eic::TrackParametersCollection& tracks, SurfaceT&& surface,
+                                std::span<Cov6f> out) {
+  if (out.size() != tracks.size()) {
+    throw std::invalid_argument("edm4eic bound_to_position_momentum: inconsistent batch sizes");
+  }
+  for (std::size_t i = 0; i < tracks.size(); ++i) {
+    const auto params = tracks[i];
+    out[i] = bound_to_position_momentum(params, surface(params.getSurface()));
+  }
+}
+
+} // namespace edm4eic
+
+#endif
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_DATAFRAME_HH
+#define EDM4EIC_UTILS_DATAFRAME_HH
+
+#include <ROOT/RVec.hxx>
+#include <Math/Vector4D.h>
+
+#include <edm4eic/CalorimeterHitData.h>
+#include <edm4eic/ClusterData.h>
+#include <edm4eic/ReconstructedParticleData.h>
+#include <edm4eic/TrackParametersData.h>
+
+/** RDataFrame column functions.
+ * Compiled functions of the collection columns of edm4eic files, e.g.
+ *
+ *   ROOT::EnableImplicitMT();
+ *   ROOT::RDataFrame df("events", "rec.edm4eic.root");
+ *   auto pt = df.Define("pt", edm4eic::rdf::pt, {"ReconstructedParticles"});
+ *
+ * They are passed as callables; no dictionary is generated for them, so
+ * JIT-ed string expressions only see them after this header has been
+ * declared to the interpreter. All functions are free of state and safe to
+ * call from the RDataFrame worker threads. They are computed in double
+ * precision and return floats, like the stored members.
+ * The library is edm4eic::edm4eicRDF.
+ */
+namespace edm4eic::rdf {
+
+template <typename T> using RVec = ROOT::VecOps::RVec<T>;
+
+// Reconstructed particles
+
+/// Momentum magnitude
+RVec<float> p(const RVec<edm4eic::ReconstructedParticleData>& particles);
+/// Transverse momentum
+RVec<float> pt(const RVec<edm4eic::ReconstructedParticleData>& particles);
+/// Polar angle of the momentum [rad]
+RVec<float> theta(const RVec<edm4eic::ReconstructedParticleData>& particles);
+/// Azimuthal angle of the momentum [rad]
+RVec<float> phi(const RVec<edm4eic::ReconstructedParticleData>& particles);
+/// Pseudorapidity as the batched edm4eic::eta; +-infinity along the beam axis, where edm4eic::eta(v) differs
+RVec<float> eta(const RVec<edm4eic::ReconstructedParticleData>& particles);
+/// Rapidity from energy and longitudinal momentum
+RVec<float> rapidity(const RVec<edm4eic::ReconstructedParticleData>& particles);
+/// Four momenta from momentum and energy
+RVec<ROOT::Math::PxPyPzEVector> momenta(const RVec<edm4eic::ReconstructedParticleData>& particles);
+
+// Track parameters; |qOverP| < 1e-9 gives zero momentum, as in momenta_from_tracking
+
+/// Momentum magnitude
+RVec<float> track_p(const RVec<edm4eic::TrackParametersData>& tracks);
+/// Transverse momentum
+RVec<float> track_pt(const RVec<edm4eic::TrackParametersData>& tracks);
+/// Pseudorapidity from theta
+RVec<float> track_eta(const RVec<edm4eic::TrackParametersData>& tracks);
+/** Four momenta with a mass hypothesis.
+ * Uses the batched momenta_from_tracking; bind the mass for RDataFrame, e.g.
+ * [](const RVec<edm4eic::TrackParametersData>& t) { return edm4eic::rdf::track_momenta(t, 0.13957); }
+ */
+RVec<ROOT::Math::PxPyPzMVector> track_momenta(const RVec<edm4eic::TrackParametersData>& tracks, double mass);
+
+// Clusters and calorimeter hits
+
+/// Pseudorapidity of the cluster positions
+RVec<float> cluster_eta(const RVec<edm4eic::ClusterData>& clusters);
+/// Azimuthal angle of the cluster positions [rad]
+RVec<float> cluster_phi(const RVec<edm4eic::ClusterData>& clusters);
+/// Total energy of all clusters [GeV]
+float cluster_energy_sum(const RVec<edm4eic::ClusterData>& clusters);
+/// Total energy of all hits [GeV]
+float hit_energy_sum(const RVec<edm4eic::CalorimeterHitData>& hits);
+
+} // namespace edm4eic::rdf
+
+#endif
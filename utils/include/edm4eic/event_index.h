@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_EVENT_INDEX_HH
+#define EDM4EIC_UTILS_EVENT_INDEX_HH
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace edm4eic {
+
+/** Sidecar event index file format.
+ * A small columnar file with one value per entry of a data file and
+ * column, e.g. Q2 of one kinematics method or the size of a collection,
+ * so that events can be selected without reading any frame:
+ *
+ *   header     magic "E4EIDX01", uint64 entries, uint32 columns, uint32 0
+ *   columns    per column: char name[64], uint32 type, uint32 0, uint64 offset
+ *   data       per column: `entries` values at `offset`, 8-byte aligned
+ *
+ * Values are stored in native (little-endian) byte order. Float columns use
+ * NaN for entries without a value.
+ */
+namespace event_index_format {
+inline constexpr std::array<char, 8> magic{'E', '4', 'E', 'I', 'D', 'X', '0', '1'};
+inline constexpr std::size_t name_size = 64;
+enum class column_type : uint32_t { float32 = 0, uint32 = 1 };
+
+struct header {
+  std::array<char, 8> magic;
+  uint64_t entries;
+  uint32_t columns;
+  uint32_t reserved;
+};
+struct column {
+  std::array<char, name_size> name;
+  column_type type;
+  uint32_t reserved;
+  uint64_t offset;
+};
+} // namespace event_index_format
+
+/// Collects the columns of an event index and writes the file
+class event_index_builder {
+public:
+  explicit event_index_builder(std::size_t entries) : m_entries{entries} {}
+
+  std::size_t entries() const { return m_entries; }
+
+  /// Add a float column, initialized to NaN; entries may be filled from several threads
+  std::span<float> add_float(const std::string& name) {
+    check_name(name);
+    auto& column = m_floats.emplace_back(name, std::vector<float>(m_entries, std::numeric_limits<float>::quiet_NaN()));
+    return column.second;
+  }
+
+  /// Add an unsigned column, e.g. a collection size, initialized to 0
+  std::span<uint32_t> add_count(const std::string& name) {
+    check_name(name);
+    auto& column = m_counts.emplace_back(name, std::vector<uint32_t>(m_entries, 0));
+    return column.second;
+  }
+
+  void write(const std::string& path) const {
+    namespace fmt = event_index_format;
+    const std::size_t columns = m_floats.size() + m_counts.size();
+    std::vector<fmt::column> descriptors;
+    uint64_t offset = sizeof(fmt::header) + columns * sizeof(fmt::column);
+    auto describe = [&](const std::string& name, fmt::column_type type, std::size_t bytes) {
+      fmt::column descriptor{};
+      std::copy(name.begin(), name.end(), descriptor.name.begin());
+      descriptor.type = type;
+      descriptor.offset = offset;
+      descriptors.push_back(descriptor);
+      offset += (bytes + 7) / 8 * 8;
+    };
+    for (const auto& [name, values] : m_floats) {
+      describe(name, fmt::column_type::float32, values.size() * sizeof(float));
+    }
+    for (const auto& [name, values] : m_counts) {
+      describe(name, fmt::column_type::uint32, values.size() * sizeof(uint32_t));
+    }
+
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    if (!out) {
+      throw std::runtime_error("event_index: cannot write " + path);
+    }
+    const fmt::header header{fmt::magic, m_entries, static_cast<uint32_t>(columns), 0};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(descriptors.data()),
+              static_cast<std::streamsize>(descriptors.size() * sizeof(fmt::column)));
+    auto write_column = [&out](const void* data, std::size_t bytes) {
+      static constexpr std::array<char, 8> padding{};
+      out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+      out.write(padding.data(), static_cast<std::streamsize>((8 - bytes % 8) % 8));
+    };
+    for (const auto& [name, values] : m_floats) {
+      write_column(values.data(), values.size() * sizeof(float));
+    }
+    for (const auto& [name, values] : m_counts) {
+      write_column(values.data(), values.size() * sizeof(uint32_t));
+    }
+    if (!out) {
+      throw std::runtime_error("event_index: error writing " + path);
+    }
+  }
+
+private:
+  void check_name(const std::string& name) const {
+    if (name.empty() || name.size() >= event_index_format::name_size) {
+      throw std::invalid_argument("event_index: invalid column name '" + name + "'");
+    }
+  }
+
+  std::size_t m_entries;
+  std::vector<std::pair<std::string, std::vector<float>>> m_floats;
+  std::vector<std::pair<std::string, std::vector<uint32_t>>> m_counts;
+};
+
+/** Memory-mapped event index.
+ * Columns are accessed in place, and select() returns the entries that
+ * pass all range predicates, for random access with e.g.
+ * ROOTReader::readEntry().
+ */
+class event_index {
+public:
+  /// Inclusive range on a column; NaN values never pass
+  struct range {
+    std::string column;
+    double min{-std::numeric_limits<double>::infinity()};
+    double max{std::numeric_limits<double>::infinity()};
+  };
+
+  explicit event_index(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("event_index: cannot open " + path);
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(event_index_format::header)) {
+      ::close(fd);
+      throw std::runtime_error("event_index: " + path + " is not an event index");
+    }
+    m_size = static_cast<std::size_t>(st.st_size);
+    m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (m_data == MAP_FAILED) {
+      m_data = nullptr;
+      throw std::runtime_error("event_index: cannot map " + path);
+    }
+    try {
+      parse(path);
+    } catch (...) {
+      unmap();
+      throw;
+    }
+  }
+
+  event_index(const event_index&) = delete;
+  event_index& operator=(const event_index&) = delete;
+  event_index(event_index&& other) noexcept
+      : m_data{std::exchange(other.m_data, nullptr)}
+      , m_size{other.m_size}
+      , m_entries{other.m_entries}
+      , m_columns{std::move(other.m_columns)} {}
+  ~event_index() { unmap(); }
+
+  std::size_t entries() const { return m_entries; }
+
+  std::vector<std::string> columns() const {
+    std::vector<std::string> names;
+    for (const auto* column : m_columns) {
+      names.emplace_back(column->name.data());
+    }
+    return names;
+  }
+
+  std::span<const float> floats(std::string_view name) const {
+    return {static_cast<const float*>(find(name, event_index_format::column_type::float32)), m_entries};
+  }
+  std::span<const uint32_t> counts(std::string_view name) const {
+    return {static_cast<const uint32_t*>(find(name, event_index_format::column_type::uint32)), m_entries};
+  }
+
+  /// Entries passing all ranges, in increasing order
+  std::vector<std::size_t> select(const std::vector<range>& ranges) const {
+    std::vector<uint8_t> pass(m_entries, 1);
+    for (const auto& r : ranges) {
+      const auto* column = descriptor(r.column);
+      if (column->type == event_index_format::column_type::float32) {
+        apply(floats(r.column), r, pass);
+      } else {
+        apply(counts(r.column), r, pass);
+      }
+    }
+    std::vector<std::size_t> selected;
+    for (std::size_t i = 0; i < m_entries; ++i) {
+      if (pass[i]) {
+        selected.push_back(i);
+      }
+    }
+    return selected;
+  }
+
+private:
+  template <typename T>
+  static void apply(std::span<const T> values, const range& r, std::vector<uint8_t>& pass) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      const double v = values[i];
+      pass[i] &= static_cast<uint8_t>(v >= r.min && v <= r.max);
+    }
+  }
+
+  void parse(const std::string& path) {
+    namespace fmt = event_index_format;
+    const auto* bytes = static_cast<const char*>(m_data);
+    const auto* header = reinterpret_cast<const fmt::header*>(bytes);
+    if (header->magic != fmt::magic) {
+      throw std::runtime_error("event_index: " + path + " is not an event index");
+    }
+    m_entries = header->entries;
+    if (sizeof(fmt::header) + header->columns * sizeof(fmt::column) > m_size) {
+      throw std::runtime_error("event_index: " + path + " is truncated");
+    }
+    const auto* columns = reinterpret_cast<const fmt::column*>(bytes + sizeof(fmt::header));
+    for (uint32_t c = 0; c < header->columns; ++c) {
+      const std::size_t width = 4; // both column types are 32 bits wide
+      if (columns[c].name.back() != '\0' || columns[c].offset + m_entries * width > m_size) {
+        throw std::runtime_error("event_index: " + path + " is corrupt");
+      }
+      m_columns.push_back(&columns[c]);
+    }
+  }
+
+  const event_index_format::column* descriptor(std::string_view name) const {
+    for (const auto* column : m_columns) {
+      if (name == column->name.data()) {
+        return column;
+      }
+    }
+    throw std::out_of_range("event_index: no column '" + std::string(name) + "'");
+  }
+
+  const void* find(std::string_view name, event_index_format::column_type type) const {
+    const auto* column = descriptor(name);
+    if (column->type != type) {
+      throw std::invalid_argument("event_index: column '" + std::string(name) + "' has a different type");
+    }
+    return static_cast<const char*>(m_data) + column->offset;
+  }
+
+  void unmap() {
+    if (m_data != nullptr) {
+      ::munmap(m_data, m_size);
+      m_data = nullptr;
+    }
+  }
+
+  void* m_data{nullptr};
+  std::size_t m_size{0};
+  std::size_t m_entries{0};
+  std::vector<const event_index_format::column*> m_columns;
+};
+
+} // namespace edm4eic
+
+#endif
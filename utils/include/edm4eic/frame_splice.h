@@ -0,0 +1,536 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_FRAME_SPLICE_HH
+#define EDM4EIC_UTILS_FRAME_SPLICE_HH
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <podio/CollectionBufferFactory.h>
+#include <podio/CollectionBuffers.h>
+#include <podio/CollectionIDTable.h>
+#include <podio/GenericParameters.h>
+#include <podio/ObjectID.h>
+
+#include <edm4hep/CaloHitContributionCollection.h>
+#include <edm4hep/MCParticleCollection.h>
+#include <edm4hep/SimCalorimeterHitCollection.h>
+#include <edm4hep/SimTrackerHitCollection.h>
+
+#include <edm4eic/RawCALOROCHitCollection.h>
+#include <edm4eic/SimPulseCollection.h>
+
+namespace edm4eic {
+
+/// Time offset applied to spliced objects
+struct splice_time {
+  double offset{0};     // [ns] added to all times
+  double tdc_period{0}; // [ns] per TDC count for integer time stamps, which are not shifted if zero
+};
+
+/** Splice traits.
+ * Describe how a podio data struct refers into the relation and
+ * VectorMember buffers of its collection. Each OneToManyRelation and
+ * VectorMember is stored as a [begin, end) range in the data struct, which
+ * has to be shifted when the struct is appended behind existing entries.
+ * OneToManyRelations come first in the relation buffers, followed by
+ * OneToOneRelations which need no shifting. Times are moved by
+ * shift_time when a splice_time offset is given. Only datatypes with a
+ * specialization can be spliced.
+ */
+template <typename DataT> struct splice_traits;
+
+template <> struct splice_traits<edm4hep::SimTrackerHitData> {
+  using vector_members = std::tuple<>;
+  static void shift(edm4hep::SimTrackerHitData&, std::span<const unsigned>, std::span<const unsigned>) {}
+  static void shift_time(edm4hep::SimTrackerHitData& data, const splice_time& time) { data.time += time.offset; }
+};
+
+template <> struct splice_traits<edm4hep::CaloHitContributionData> {
+  using vector_members = std::tuple<>;
+  static void shift(edm4hep::CaloHitContributionData&, std::span<const unsigned>, std::span<const unsigned>) {}
+  static void shift_time(edm4hep::CaloHitContributionData& data, const splice_time& time) { data.time += time.offset; }
+};
+
+// SimCalorimeterHit has no time of its own, it is kept in the contributions
+template <> struct splice_traits<edm4hep::SimCalorimeterHitData> {
+  using vector_members = std::tuple<>;
+  static void shift(edm4hep::SimCalorimeterHitData& data, std::span<const unsigned> relations, std::span<const unsigned>) {
+    data.contributions_begin += relations[0];
+    data.contributions_end += relations[0];
+  }
+  static void shift_time(edm4hep::SimCalorimeterHitData&, const splice_time&) {}
+};
+
+template <> struct splice_traits<edm4hep::MCParticleData> {
+  using vector_members = std::tuple<>;
+  static void shift(edm4hep::MCParticleData& data, std::span<const unsigned> relations, std::span<const unsigned>) {
+    data.parents_begin += relations[0];
+    data.parents_end += relations[0];
+    data.daughters_begin += relations[1];
+    data.daughters_end += relations[1];
+  }
+  static void shift_time(edm4hep::MCParticleData& data, const splice_time& time) { data.time += time.offset; }
+};
+
+template <> struct splice_traits<edm4eic::SimPulseData> {
+  using vector_members = std::tuple<float>;
+  static void shift(edm4eic::SimPulseData& data, std::span<const unsigned> relations, std::span<const unsigned> vectors) {
+    data.calorimeterHits_begin += relations[0];
+    data.calorimeterHits_end += relations[0];
+    data.trackerHits_begin += relations[1];
+    data.trackerHits_end += relations[1];
+    data.pulses_begin += relations[2];
+    data.pulses_end += relations[2];
+    data.particles_begin += relations[3];
+    data.particles_end += relations[3];
+    data.amplitude_begin += vectors[0];
+    data.amplitude_end += vectors[0];
+  }
+  static void shift_time(edm4eic::SimPulseData& data, const splice_time& time) { data.time += time.offset; }
+};
+
+template <> struct splice_traits<edm4eic::RawCALOROCHitData> {
+  using vector_members = std::tuple<edm4eic::CALOROC1ASample, edm4eic::CALOROC1BSample>;
+  static void shift(edm4eic::RawCALOROCHitData& data, std::span<const unsigned>, std::span<const unsigned> vectors) {
+    data.aSamples_begin += vectors[0];
+    data.aSamples_end += vectors[0];
+    data.bSamples_begin += vectors[1];
+    data.bSamples_end += vectors[1];
+  }
+  static void shift_time(edm4eic::RawCALOROCHitData& data, const splice_time& time) {
+    if (time.tdc_period > 0) {
+      data.timeStamp += static_cast<int32_t>(std::lround(time.offset / time.tdc_period));
+    }
+  }
+};
+
+/** Relation remapping.
+ * Maps an ObjectID in a source frame onto the spliced output. Objects in
+ * collections that are spliced move by the number of entries already present
+ * in the output collection; relations into any other collection cannot be
+ * resolved in the output and are invalidated (and counted).
+ */
+class relation_remap {
+public:
+  void add(uint32_t src_id, uint32_t dst_id, int offset) { m_entries.push_back({src_id, dst_id, offset}); }
+
+  podio::ObjectID operator()(podio::ObjectID id) const {
+    if (id.index < 0) {
+      return id;
+    }
+    for (const auto& entry : m_entries) {
+      if (entry.src_id == id.collectionID) {
+        return {id.index + entry.offset, entry.dst_id};
+      }
+    }
+    ++m_dropped;
+    return {podio::ObjectID::invalid, static_cast<uint32_t>(podio::ObjectID::invalid)};
+  }
+
+  /// Number of relations invalidated since construction
+  std::size_t dropped() const { return m_dropped; }
+
+private:
+  struct entry {
+    uint32_t src_id;
+    uint32_t dst_id;
+    int offset;
+  };
+  std::vector<entry> m_entries;
+  mutable std::size_t m_dropped{0};
+};
+
+namespace detail {
+
+  template <typename VecT, typename BuffersT>
+  std::vector<VecT>* vector_member(BuffersT& buffers, std::size_t i) {
+    return static_cast<std::vector<VecT>*>((*buffers.vectorMembers)[i].second);
+  }
+
+  template <typename VecT, typename BuffersT>
+  const std::vector<VecT>* vector_member(const BuffersT& buffers, std::size_t i) {
+    return static_cast<const std::vector<VecT>*>((*buffers.vectorMembers)[i].second);
+  }
+
+  template <typename... VecTs, std::size_t... Is>
+  void splice_vector_members(podio::CollectionReadBuffers& dst, const podio::CollectionReadBuffers& src,
+                             std::span<unsigned> offsets, std::tuple<VecTs...>*, std::index_sequence<Is...>) {
+    (
+        [&] {
+          auto* dst_vec = vector_member<VecTs>(dst, Is);
+          const auto* src_vec = vector_member<VecTs>(src, Is);
+          offsets[Is] = dst_vec->size();
+          dst_vec->insert(dst_vec->end(), src_vec->begin(), src_vec->end());
+        }(),
+        ...);
+  }
+
+  template <typename... VecTs, std::size_t... Is>
+  std::size_t vector_member_bytes(const podio::CollectionReadBuffers& buffers, std::tuple<VecTs...>*,
+                                  std::index_sequence<Is...>) {
+    return (std::size_t{0} + ... + (vector_member<VecTs>(buffers, Is)->size() * sizeof(VecTs)));
+  }
+
+} // namespace detail
+
+/// Approximate memory held by a collection buffer of DataT
+template <typename DataT>
+std::size_t buffer_bytes(const podio::CollectionReadBuffers& buffers) {
+  using traits = splice_traits<DataT>;
+  std::size_t bytes = static_cast<const std::vector<DataT>*>(buffers.data)->size() * sizeof(DataT);
+  for (const auto& refs : *buffers.references) {
+    bytes += refs->size() * sizeof(podio::ObjectID);
+  }
+  return bytes + detail::vector_member_bytes(buffers, static_cast<typename traits::vector_members*>(nullptr),
+                                             std::make_index_sequence<std::tuple_size_v<typename traits::vector_members>>{});
+}
+
+/** Append one collection buffer to another.
+ * The data structs and VectorMember contents of `src` are appended to `dst`
+ * in bulk, their ranges and times shifted, and all relation ObjectIDs are
+ * remapped in a single pass. Both buffers must hold a collection of DataT
+ * in the current schema version, see splice_ops::check_schema.
+ */
+template <typename DataT>
+void splice_buffers(podio::CollectionReadBuffers& dst, const podio::CollectionReadBuffers& src,
+                    const relation_remap& remap, const splice_time& time) {
+  using traits = splice_traits<DataT>;
+  constexpr std::size_t n_vector_members = std::tuple_size_v<typename traits::vector_members>;
+
+  auto* dst_data = static_cast<std::vector<DataT>*>(dst.data);
+  const auto* src_data = static_cast<const std::vector<DataT>*>(src.data);
+  const std::size_t first = dst_data->size();
+
+  // relations
+  std::vector<unsigned> relation_offsets(dst.references->size());
+  for (std::size_t k = 0; k < dst.references->size(); ++k) {
+    auto& dst_refs = *(*dst.references)[k];
+    const auto& src_refs = *(*src.references)[k];
+    relation_offsets[k] = dst_refs.size();
+    dst_refs.reserve(dst_refs.size() + src_refs.size());
+    for (const auto& id : src_refs) {
+      dst_refs.push_back(remap(id));
+    }
+  }
+
+  // vector members
+  std::array<unsigned, n_vector_members> vector_offsets{};
+  if constexpr (n_vector_members > 0) {
+    detail::splice_vector_members(dst, src, std::span<unsigned>{vector_offsets},
+                                  static_cast<typename traits::vector_members*>(nullptr),
+                                  std::make_index_sequence<n_vector_members>{});
+  }
+
+  // data
+  dst_data->insert(dst_data->end(), src_data->begin(), src_data->end());
+  const bool shift_time = time.offset != 0;
+  for (std::size_t i = first; i < dst_data->size(); ++i) {
+    traits::shift((*dst_data)[i], relation_offsets, vector_offsets);
+    if (shift_time) {
+      traits::shift_time((*dst_data)[i], time);
+    }
+  }
+}
+
+/// Shift the times of all objects in a collection buffer of DataT
+template <typename DataT>
+void shift_buffer_times(podio::CollectionReadBuffers& buffers, const splice_time& time) {
+  for (auto& data : *static_cast<std::vector<DataT>*>(buffers.data)) {
+    splice_traits<DataT>::shift_time(data, time);
+  }
+}
+
+/// Type-erased splicing operations for one collection type
+struct splice_ops {
+  std::string_view collection_type;
+  podio::SchemaVersionT schema_version; // the only version of the buffers that can be spliced
+  std::size_t (*size)(const podio::CollectionReadBuffers&);
+  std::size_t (*bytes)(const podio::CollectionReadBuffers&);
+  void (*append)(podio::CollectionReadBuffers&, const podio::CollectionReadBuffers&, const relation_remap&,
+                 const splice_time&);
+  void (*shift_times)(podio::CollectionReadBuffers&, const splice_time&);
+
+  /** Reject buffers written with another schema version.
+   * The buffers are reinterpreted as the current data structs, so buffers of
+   * an older schema, e.g. from an older background file, would be misread.
+   * They are not evolved here; read such files through a podio::Frame, which
+   * applies the schema evolution.
+   */
+  void check_schema(const podio::CollectionReadBuffers& buffers, const std::string& name) const {
+    if (buffers.schemaVersion != schema_version) {
+      throw std::runtime_error("edm4eic frame_splice: collection " + name + " of type " + std::string(collection_type) +
+                               " has schema version " + std::to_string(buffers.schemaVersion) + ", expected " +
+                               std::to_string(schema_version));
+    }
+  }
+};
+
+namespace detail {
+
+  template <typename CollT, typename DataT>
+  constexpr splice_ops make_splice_ops() {
+    return {CollT::typeName, CollT::schemaVersion,
+            [](const podio::CollectionReadBuffers& buffers) {
+              return static_cast<const std::vector<DataT>*>(buffers.data)->size();
+            },
+            &buffer_bytes<DataT>, &splice_buffers<DataT>, &shift_buffer_times<DataT>};
+  }
+
+} // namespace detail
+
+/// Splicing operations for a collection type name, if supported
+inline const splice_ops* find_splice_ops(std::string_view collection_type) {
+  static constexpr splice_ops ops[] = {
+      detail::make_splice_ops<edm4hep::SimTrackerHitCollection, edm4hep::SimTrackerHitData>(),
+      detail::make_splice_ops<edm4hep::SimCalorimeterHitCollection, edm4hep::SimCalorimeterHitData>(),
+      detail::make_splice_ops<edm4hep::CaloHitContributionCollection, edm4hep::CaloHitContributionData>(),
+      detail::make_splice_ops<edm4hep::MCParticleCollection, edm4hep::MCParticleData>(),
+      detail::make_splice_ops<edm4eic::SimPulseCollection, edm4eic::SimPulseData>(),
+      detail::make_splice_ops<edm4eic::RawCALOROCHitCollection, edm4eic::RawCALOROCHitData>(),
+  };
+  const auto* it = std::find_if(std::begin(ops), std::end(ops),
+                                [&](const auto& op) { return op.collection_type == collection_type; });
+  return it != std::end(ops) ? it : nullptr;
+}
+
+/** Collection buffers of one frame.
+ * Holds the (not yet unpacked) buffers of selected collections taken from
+ * a reader's frame data, e.g. podio::ROOTFrameData. Collections can be
+ * spliced at the buffer level and the result handed to a podio::Frame,
+ * since this class provides the FrameData interface. Buffers that are never
+ * handed out are deleted with this object.
+ */
+class frame_buffers {
+public:
+  frame_buffers() = default;
+
+  /// Take the buffers for the collections `names` (where present) out of `data`
+  template <typename FrameDataT>
+  frame_buffers(std::unique_ptr<FrameDataT> data, const std::vector<std::string>& names) {
+    const auto table = data->getIDTable();
+    for (const auto& name : names) {
+      auto buffers = data->getCollectionBuffers(name);
+      auto id = table.collectionID(name);
+      if (!buffers || !id) {
+        continue;
+      }
+      m_names.push_back(name);
+      m_ids.push_back(*id);
+      m_buffers.push_back(std::move(buffers));
+    }
+    m_parameters = data->getParameters();
+  }
+
+  /// Empty buffers for the same collections as `other`
+  static frame_buffers empty_like(const frame_buffers& other) {
+    frame_buffers empty;
+    for (std::size_t i = 0; i < other.m_names.size(); ++i) {
+      const auto& buffers = other.m_buffers[i];
+      if (!buffers) {
+        continue;
+      }
+      auto created = podio::CollectionBufferFactory::instance().createBuffers(
+          std::string(buffers->type), buffers->schemaVersion, buffers->data == nullptr);
+      if (!created) {
+        continue;
+      }
+      empty.m_names.push_back(other.m_names[i]);
+      empty.m_ids.push_back(other.m_ids[i]);
+      empty.m_buffers.push_back(std::move(created));
+    }
+    return empty;
+  }
+
+  frame_buffers(const frame_buffers&) = delete;
+  frame_buffers& operator=(const frame_buffers&) = delete;
+  frame_buffers(frame_buffers&&) = default;
+
+  frame_buffers& operator=(frame_buffers&& other) {
+    if (this != &other) {
+      release();
+      m_names = std::move(other.m_names);
+      m_ids = std::move(other.m_ids);
+      m_buffers = std::move(other.m_buffers);
+      m_parameters = std::move(other.m_parameters);
+    }
+    return *this;
+  }
+
+  ~frame_buffers() { release(); }
+
+  // FrameData interface for podio::Frame
+  podio::CollectionIDTable getIDTable() const {
+    return podio::CollectionIDTable(std::vector<uint32_t>(m_ids), std::vector<std::string>(m_names));
+  }
+
+  std::optional<podio::CollectionReadBuffers> getCollectionBuffers(const std::string& name) {
+    const auto i = index(name);
+    if (!i) {
+      return std::nullopt;
+    }
+    return std::exchange(m_buffers[*i], std::nullopt);
+  }
+
+  std::vector<std::string> getAvailableCollections() const { return m_names; }
+
+  std::unique_ptr<podio::GenericParameters> getParameters() {
+    return m_parameters ? std::move(m_parameters) : std::make_unique<podio::GenericParameters>();
+  }
+
+  /// Frame parameters, e.g. to add parameters before handing over to a podio::Frame
+  podio::GenericParameters& parameters() {
+    if (!m_parameters) {
+      m_parameters = std::make_unique<podio::GenericParameters>();
+    }
+    return *m_parameters;
+  }
+
+  // Access for splicing
+  const std::vector<std::string>& names() const { return m_names; }
+
+  const podio::CollectionReadBuffers* buffers(const std::string& name) const {
+    const auto i = index(name);
+    return i && m_buffers[*i] ? &*m_buffers[*i] : nullptr;
+  }
+
+  podio::CollectionReadBuffers* buffers(const std::string& name) {
+    const auto i = index(name);
+    return i && m_buffers[*i] ? &*m_buffers[*i] : nullptr;
+  }
+
+  /// Approximate memory held by the spliceable buffers
+  std::size_t bytes() const {
+    std::size_t total = 0;
+    for (const auto& buffers : m_buffers) {
+      const auto* ops = buffers ? find_splice_ops(buffers->type) : nullptr;
+      if (ops != nullptr) {
+        total += ops->bytes(*buffers);
+      }
+    }
+    return total;
+  }
+
+  /// Add the buffers of a new collection, e.g. built by a collection_arena; they are owned by this object
+  void put(const std::string& name, uint32_t id, podio::CollectionReadBuffers buffers) {
+    if (index(name)) {
+      if (buffers.deleteBuffers) {
+        buffers.deleteBuffers(buffers);
+      }
+      throw std::invalid_argument("frame_buffers: collection " + name + " already present");
+    }
+    m_names.push_back(name);
+    m_ids.push_back(id);
+    m_buffers.push_back(std::move(buffers));
+  }
+
+  std::optional<uint32_t> collectionID(const std::string& name) const {
+    const auto i = index(name);
+    return i ? std::optional<uint32_t>{m_ids[*i]} : std::nullopt;
+  }
+
+private:
+  void release() {
+    for (auto& buffers : m_buffers) {
+      if (buffers && buffers->deleteBuffers) {
+        buffers->deleteBuffers(*buffers);
+      }
+    }
+    m_buffers.clear();
+  }
+
+  std::optional<std::size_t> index(const std::string& name) const {
+    const auto it = std::find(m_names.begin(), m_names.end(), name);
+    return it != m_names.end() ? std::optional<std::size_t>{it - m_names.begin()} : std::nullopt;
+  }
+
+  std::vector<std::string> m_names;
+  std::vector<uint32_t> m_ids;
+  std::vector<std::optional<podio::CollectionReadBuffers>> m_buffers;
+  std::unique_ptr<podio::GenericParameters> m_parameters;
+};
+
+/** Restrict relations to the collections held in `frame`.
+ * Relations into any other collection are invalidated, since they cannot be
+ * resolved once only these collections are written. Returns the number of
+ * invalidated relations.
+ */
+inline std::size_t restrict_relations(frame_buffers& frame) {
+  relation_remap remap;
+  for (const auto& name : frame.names()) {
+    remap.add(*frame.collectionID(name), *frame.collectionID(name), 0);
+  }
+  for (const auto& name : frame.names()) {
+    auto* buffers = frame.buffers(name);
+    if (buffers == nullptr || buffers->references == nullptr) {
+      continue;
+    }
+    for (auto& refs : *buffers->references) {
+      std::transform(refs->begin(), refs->end(), refs->begin(), remap);
+    }
+  }
+  return remap.dropped();
+}
+
+/// Shift the times of all objects in `frame`
+inline void shift_times(frame_buffers& frame, const splice_time& time) {
+  for (const auto& name : frame.names()) {
+    auto* buffers = frame.buffers(name);
+    const auto* ops = buffers ? find_splice_ops(buffers->type) : nullptr;
+    if (ops != nullptr) {
+      ops->check_schema(*buffers, name);
+      ops->shift_times(*buffers, time);
+    }
+  }
+}
+
+/** Splice all collections of `src` onto the same-named collections of `dst`.
+ * Collections are matched by name and type; relations into collections that
+ * are not part of `dst` are invalidated. The spliced objects are moved in
+ * time by `time`. Returns the number of invalidated relations. Throws
+ * std::runtime_error if a collection is not in the current schema version.
+ */
+inline std::size_t splice(frame_buffers& dst, const frame_buffers& src, const splice_time& time = {}) {
+  // entries already in the output define where the source objects end up
+  relation_remap remap;
+  for (const auto& name : dst.names()) {
+    const auto* dst_buffers = dst.buffers(name);
+    const auto* src_buffers = src.buffers(name);
+    const auto* ops = dst_buffers ? find_splice_ops(dst_buffers->type) : nullptr;
+    if (ops == nullptr || src_buffers == nullptr || src_buffers->type != dst_buffers->type) {
+      continue;
+    }
+    ops->check_schema(*dst_buffers, name);
+    ops->check_schema(*src_buffers, name);
+    remap.add(*src.collectionID(name), *dst.collectionID(name), static_cast<int>(ops->size(*dst_buffers)));
+  }
+
+  for (const auto& name : dst.names()) {
+    auto* dst_buffers = dst.buffers(name);
+    const auto* src_buffers = src.buffers(name);
+    const auto* ops = dst_buffers ? find_splice_ops(dst_buffers->type) : nullptr;
+    if (ops == nullptr || src_buffers == nullptr || src_buffers->type != dst_buffers->type) {
+      continue;
+    }
+    ops->append(*dst_buffers, *src_buffers, remap, time);
+  }
+
+  return remap.dropped();
+}
+
+} // namespace edm4eic
+
+#endif
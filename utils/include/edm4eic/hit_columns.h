@@ -0,0 +1,261 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_HIT_COLUMNS_HH
+#define EDM4EIC_UTILS_HIT_COLUMNS_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <podio/Frame.h>
+
+#include <edm4eic/CalorimeterHitCollection.h>
+#include <edm4eic/PMTHitCollection.h>
+#include <edm4eic/TrackerHitCollection.h>
+
+namespace edm4eic {
+
+namespace detail {
+
+/** Lazily filled columns of a collection.
+ * Each column is copied out of the collection on first access and kept for
+ * the lifetime of the view, so a kernel only streams the members it uses.
+ * Filling a column is not thread-safe; share a view between threads only
+ * after the columns they need have been requested once.
+ */
+template <typename CollT> class collection_columns {
+public:
+  using collection_type = CollT;
+
+  explicit collection_columns(const CollT& collection) : m_collection{&collection} {}
+
+  std::size_t size() const { return m_collection->size(); }
+  const CollT& collection() const { return *m_collection; }
+
+protected:
+  template <typename T, typename GetterT>
+  std::span<const T> column(std::optional<std::vector<T>>& cache, GetterT getter) const {
+    if (!cache) {
+      std::vector<T> values(m_collection->size());
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = getter((*m_collection)[i]);
+      }
+      cache = std::move(values);
+    }
+    return *cache;
+  }
+
+private:
+  const CollT* m_collection;
+};
+
+} // namespace detail
+
+/// Columnar view of a CalorimeterHitCollection
+class calorimeter_hit_columns : public detail::collection_columns<CalorimeterHitCollection> {
+public:
+  using collection_columns::collection_columns;
+
+  std::span<const uint64_t> cellID() const {
+    return column(m_cellID, [](const auto& hit) { return hit.getCellID(); });
+  }
+  std::span<const float> energy() const {
+    return column(m_energy, [](const auto& hit) { return hit.getEnergy(); });
+  }
+  std::span<const float> energyError() const {
+    return column(m_energyError, [](const auto& hit) { return hit.getEnergyError(); });
+  }
+  std::span<const float> time() const {
+    return column(m_time, [](const auto& hit) { return hit.getTime(); });
+  }
+  std::span<const float> timeError() const {
+    return column(m_timeError, [](const auto& hit) { return hit.getTimeError(); });
+  }
+  std::span<const float> position_x() const {
+    return column(m_position_x, [](const auto& hit) { return hit.getPosition().x; });
+  }
+  std::span<const float> position_y() const {
+    return column(m_position_y, [](const auto& hit) { return hit.getPosition().y; });
+  }
+  std::span<const float> position_z() const {
+    return column(m_position_z, [](const auto& hit) { return hit.getPosition().z; });
+  }
+  std::span<const float> dimension_x() const {
+    return column(m_dimension_x, [](const auto& hit) { return hit.getDimension().x; });
+  }
+  std::span<const float> dimension_y() const {
+    return column(m_dimension_y, [](const auto& hit) { return hit.getDimension().y; });
+  }
+  std::span<const float> dimension_z() const {
+    return column(m_dimension_z, [](const auto& hit) { return hit.getDimension().z; });
+  }
+  std::span<const int32_t> sector() const {
+    return column(m_sector, [](const auto& hit) { return hit.getSector(); });
+  }
+  std::span<const int32_t> layer() const {
+    return column(m_layer, [](const auto& hit) { return hit.getLayer(); });
+  }
+  std::span<const float> local_x() const {
+    return column(m_local_x, [](const auto& hit) { return hit.getLocal().x; });
+  }
+  std::span<const float> local_y() const {
+    return column(m_local_y, [](const auto& hit) { return hit.getLocal().y; });
+  }
+  std::span<const float> local_z() const {
+    return column(m_local_z, [](const auto& hit) { return hit.getLocal().z; });
+  }
+
+private:
+  mutable std::optional<std::vector<uint64_t>> m_cellID;
+  mutable std::optional<std::vector<float>> m_energy, m_energyError, m_time, m_timeError;
+  mutable std::optional<std::vector<float>> m_position_x, m_position_y, m_position_z;
+  mutable std::optional<std::vector<float>> m_dimension_x, m_dimension_y, m_dimension_z;
+  mutable std::optional<std::vector<int32_t>> m_sector, m_layer;
+  mutable std::optional<std::vector<float>> m_local_x, m_local_y, m_local_z;
+};
+
+/// Columnar view of a TrackerHitCollection
+class tracker_hit_columns : public detail::collection_columns<TrackerHitCollection> {
+public:
+  using collection_columns::collection_columns;
+
+  std::span<const uint64_t> cellID() const {
+    return column(m_cellID, [](const auto& hit) { return hit.getCellID(); });
+  }
+  std::span<const float> position_x() const {
+    return column(m_position_x, [](const auto& hit) { return hit.getPosition().x; });
+  }
+  std::span<const float> position_y() const {
+    return column(m_position_y, [](const auto& hit) { return hit.getPosition().y; });
+  }
+  std::span<const float> position_z() const {
+    return column(m_position_z, [](const auto& hit) { return hit.getPosition().z; });
+  }
+  std::span<const float> positionError_xx() const {
+    return column(m_positionError_xx, [](const auto& hit) { return hit.getPositionError().xx; });
+  }
+  std::span<const float> positionError_yy() const {
+    return column(m_positionError_yy, [](const auto& hit) { return hit.getPositionError().yy; });
+  }
+  std::span<const float> positionError_zz() const {
+    return column(m_positionError_zz, [](const auto& hit) { return hit.getPositionError().zz; });
+  }
+  std::span<const float> time() const {
+    return column(m_time, [](const auto& hit) { return hit.getTime(); });
+  }
+  std::span<const float> timeError() const {
+    return column(m_timeError, [](const auto& hit) { return hit.getTimeError(); });
+  }
+  std::span<const float> edep() const {
+    return column(m_edep, [](const auto& hit) { return hit.getEdep(); });
+  }
+  std::span<const float> edepError() const {
+    return column(m_edepError, [](const auto& hit) { return hit.getEdepError(); });
+  }
+
+private:
+  mutable std::optional<std::vector<uint64_t>> m_cellID;
+  mutable std::optional<std::vector<float>> m_position_x, m_position_y, m_position_z;
+  mutable std::optional<std::vector<float>> m_positionError_xx, m_positionError_yy,
+      m_positionError_zz;
+  mutable std::optional<std::vector<float>> m_time, m_timeError, m_edep, m_edepError;
+};
+
+/// Columnar view of a PMTHitCollection
+class pmt_hit_columns : public detail::collection_columns<PMTHitCollection> {
+public:
+  using collection_columns::collection_columns;
+
+  std::span<const uint64_t> cellID() const {
+    return column(m_cellID, [](const auto& hit) { return hit.getCellID(); });
+  }
+  std::span<const float> npe() const {
+    return column(m_npe, [](const auto& hit) { return hit.getNpe(); });
+  }
+  std::span<const float> time() const {
+    return column(m_time, [](const auto& hit) { return hit.getTime(); });
+  }
+  std::span<const float> timeError() const {
+    return column(m_timeError, [](const auto& hit) { return hit.getTimeError(); });
+  }
+  std::span<const float> position_x() const {
+    return column(m_position_x, [](const auto& hit) { return hit.getPosition().x; });
+  }
+  std::span<const float> position_y() const {
+    return column(m_position_y, [](const auto& hit) { return hit.getPosition().y; });
+  }
+  std::span<const float> position_z() const {
+    return column(m_position_z, [](const auto& hit) { return hit.getPosition().z; });
+  }
+  std::span<const float> dimension_x() const {
+    return column(m_dimension_x, [](const auto& hit) { return hit.getDimension().x; });
+  }
+  std::span<const float> dimension_y() const {
+    return column(m_dimension_y, [](const auto& hit) { return hit.getDimension().y; });
+  }
+  std::span<const float> dimension_z() const {
+    return column(m_dimension_z, [](const auto& hit) { return hit.getDimension().z; });
+  }
+  std::span<const int32_t> sector() const {
+    return column(m_sector, [](const auto& hit) { return hit.getSector(); });
+  }
+  std::span<const float> local_x() const {
+    return column(m_local_x, [](const auto& hit) { return hit.getLocal().x; });
+  }
+  std::span<const float> local_y() const {
+    return column(m_local_y, [](const auto& hit) { return hit.getLocal().y; });
+  }
+  std::span<const float> local_z() const {
+    return column(m_local_z, [](const auto& hit) { return hit.getLocal().z; });
+  }
+
+private:
+  mutable std::optional<std::vector<uint64_t>> m_cellID;
+  mutable std::optional<std::vector<float>> m_npe, m_time, m_timeError;
+  mutable std::optional<std::vector<float>> m_position_x, m_position_y, m_position_z;
+  mutable std::optional<std::vector<float>> m_dimension_x, m_dimension_y, m_dimension_z;
+  mutable std::optional<std::vector<int32_t>> m_sector;
+  mutable std::optional<std::vector<float>> m_local_x, m_local_y, m_local_z;
+};
+
+/** Columnar views of the collections of one frame.
+ * Views are created on first request and cached by collection name, so all
+ * kernels running on an event share the columns they have filled. Create
+ * one cache per frame; it must not outlive the frame.
+ *
+ *   edm4eic::column_cache columns{frame};
+ *   const auto& hits = columns.get<edm4eic::calorimeter_hit_columns>("EcalBarrelRecHits");
+ *   const auto energy = hits.energy();
+ */
+class column_cache {
+public:
+  explicit column_cache(const podio::Frame& frame) : m_frame{&frame} {}
+
+  template <typename ViewT> const ViewT& get(const std::string& name) {
+    auto& view = m_views[{name, std::type_index(typeid(ViewT))}];
+    if (!view) {
+      view = std::make_shared<const ViewT>(
+          m_frame->get<typename ViewT::collection_type>(name));
+    }
+    return *static_cast<const ViewT*>(view.get());
+  }
+
+  void clear() { m_views.clear(); }
+
+private:
+  const podio::Frame* m_frame;
+  std::map<std::pair<std::string, std::type_index>, std::shared_ptr<const void>> m_views;
+};
+
+} // namespace edm4eic
+
+#endif
@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_PARALLEL_READER_HH
+#define EDM4EIC_UTILS_PARALLEL_READER_HH
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <podio/Frame.h>
+
+namespace edm4eic {
+
+/// Order in which frames are handed to the callback of a parallel_reader
+enum class read_completion {
+  ordered,  // in entry order, on the calling thread
+  unordered // as soon as read, concurrently on the worker threads
+};
+
+/** Parallel frame reader.
+ * Splits the entries of a category into chunks that worker threads claim
+ * one after the other; every worker opens its own ReaderT (e.g.
+ * podio::ROOTReader) on the same files, so reading and unpacking scale
+ * with the number of threads. With ROOT based readers, call
+ * ROOT::EnableThreadSafety() before run().
+ *
+ * In ordered mode the workers run at most a window of entries ahead of the
+ * entry being delivered, which bounds the memory held in the reorder
+ * buffer. In unordered mode the callback has to be thread-safe.
+ */
+template <typename ReaderT> class parallel_reader {
+public:
+  parallel_reader(std::vector<std::string> filenames, unsigned threads,
+                  std::string category = "events", std::size_t chunk = 16)
+      : m_filenames{std::move(filenames)}
+      , m_threads{std::max(threads, 1u)}
+      , m_category{std::move(category)}
+      , m_chunk{std::max<std::size_t>(chunk, 1)} {
+    ReaderT reader;
+    reader.openFiles(m_filenames);
+    m_entries = reader.getEntries(m_category);
+  }
+
+  std::size_t entries() const { return m_entries; }
+
+  /** Read entries [first, first + count) and call callback(frame, entry).
+   * Rethrows the first exception of a worker or the callback, after all
+   * threads have stopped.
+   */
+  template <typename FuncT>
+  void run(FuncT&& callback, const read_completion completion = read_completion::unordered,
+           const std::size_t first = 0,
+           const std::size_t count = std::numeric_limits<std::size_t>::max()) {
+    const std::size_t end = first + std::min(count, m_entries - std::min(first, m_entries));
+    state s{first, end, m_chunk * m_threads * 2};
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < m_threads; ++t) {
+      workers.emplace_back([&] {
+        try {
+          work(s, callback, completion);
+        } catch (...) {
+          s.fail(std::current_exception());
+        }
+      });
+    }
+
+    if (completion == read_completion::ordered) {
+      try {
+        deliver(s, callback);
+      } catch (...) {
+        s.fail(std::current_exception());
+      }
+    }
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    if (s.error) {
+      std::rethrow_exception(s.error);
+    }
+  }
+
+private:
+  struct state {
+    state(std::size_t first, std::size_t end, std::size_t window)
+        : next_chunk{first}, end{end}, window{window}, next_delivery{first} {}
+
+    std::atomic<std::size_t> next_chunk;
+    const std::size_t end;
+    const std::size_t window;
+
+    std::mutex mutex;
+    std::condition_variable ready;   // a frame arrived in the reorder buffer
+    std::condition_variable advanced; // next_delivery moved forward
+    std::map<std::size_t, podio::Frame> buffer;
+    std::size_t next_delivery;
+    bool stopped{false};
+    std::exception_ptr error;
+
+    void fail(std::exception_ptr e) {
+      {
+        std::lock_guard lock{mutex};
+        if (!error) {
+          error = std::move(e);
+        }
+        stopped = true;
+      }
+      ready.notify_all();
+      advanced.notify_all();
+    }
+    bool is_stopped() {
+      std::lock_guard lock{mutex};
+      return stopped;
+    }
+  };
+
+  template <typename FuncT>
+  void work(state& s, FuncT& callback, const read_completion completion) {
+    ReaderT reader;
+    reader.openFiles(m_filenames);
+    while (true) {
+      const std::size_t begin = s.next_chunk.fetch_add(m_chunk);
+      if (begin >= s.end) {
+        return;
+      }
+      for (std::size_t entry = begin; entry < std::min(begin + m_chunk, s.end); ++entry) {
+        if (completion == read_completion::unordered) {
+          if (s.is_stopped()) {
+            return;
+          }
+          callback(podio::Frame(reader.readEntry(m_category, entry)), entry);
+          continue;
+        }
+        {
+          std::unique_lock lock{s.mutex};
+          s.advanced.wait(lock, [&] { return s.stopped || entry < s.next_delivery + s.window; });
+          if (s.stopped) {
+            return;
+          }
+        }
+        podio::Frame frame(reader.readEntry(m_category, entry));
+        {
+          std::lock_guard lock{s.mutex};
+          s.buffer.emplace(entry, std::move(frame));
+        }
+        s.ready.notify_one();
+      }
+    }
+  }
+
+  template <typename FuncT> void deliver(state& s, FuncT& callback) {
+    while (true) {
+      std::unique_lock lock{s.mutex};
+      if (s.next_delivery >= s.end) {
+        return;
+      }
+      s.ready.wait(lock, [&] { return s.stopped || s.buffer.contains(s.next_delivery); });
+      if (s.stopped) {
+        return;
+      }
+      auto node = s.buffer.extract(s.next_delivery);
+      const std::size_t entry = s.next_delivery++;
+      lock.unlock();
+      s.advanced.notify_all();
+      callback(std::move(node.mapped()), entry);
+    }
+  }
+
+  std::vector<std::string> m_filenames;
+  unsigned m_threads;
+  std::string m_category;
+  std::size_t m_chunk;
+  std::size_t m_entries{0};
+};
+
+} // namespace edm4eic
+
+#endif
@@ -0,0 +1,562 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_QUANTIZATION_HH
+#define EDM4EIC_UTILS_QUANTIZATION_HH
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <podio/CollectionBase.h>
+#include <podio/CollectionBuffers.h>
+#include <podio/Frame.h>
+#include <podio/GenericParameters.h>
+
+#include <edm4hep/CaloHitContributionCollection.h>
+#include <edm4hep/SimCalorimeterHitCollection.h>
+#include <edm4hep/SimTrackerHitCollection.h>
+
+#include <edm4eic/CalorimeterHitCollection.h>
+#include <edm4eic/ClusterCollection.h>
+#include <edm4eic/Measurement2DCollection.h>
+#include <edm4eic/PMTHitCollection.h>
+#include <edm4eic/RawCALOROCHitCollection.h>
+#include <edm4eic/TrackCollection.h>
+#include <edm4eic/TrackParametersCollection.h>
+#include <edm4eic/TrackerHitCollection.h>
+#include <edm4eic/VertexCollection.h>
+
+#include <edm4eic/frame_splice.h>
+
+namespace edm4eic {
+
+/** Lossy quantization of floating point values.
+ * Quantized values remain ordinary floats (or doubles) and need no
+ * dequantization on read, but their trailing mantissa bits are zero, so
+ * that the compression of the output file removes them:
+ *
+ *   mantissa:B          keep B mantissa bits (round to nearest even);
+ *                       relative error <= 2^-(B+1)
+ *   linear:B:MIN:MAX    fixed point grid over [MIN, MAX] with a power of two
+ *                       step, the smallest one >= (MAX - MIN) / 2^B; values
+ *                       are clamped to the range, absolute error <= step / 2
+ *   log:B:MIN:MAX       B bits for magnitudes in [MIN, MAX] (MIN > 0), i.e.
+ *                       a sign, the exponents that span the range and the
+ *                       remaining mantissa bits M; relative error <= 2^-(M+1),
+ *                       magnitudes below MIN become 0 and above MAX are clamped
+ *
+ * NaN and infinite values are never changed. Quantizing a value twice gives
+ * the same result as quantizing it once.
+ */
+class quantizer {
+public:
+  enum class method { none, mantissa, linear, log };
+
+  /// Identity
+  quantizer() = default;
+
+  static quantizer mantissa(unsigned bits) {
+    if (bits > 52) {
+      throw std::invalid_argument("quantizer: at most 52 mantissa bits");
+    }
+    quantizer q{method::mantissa, bits, 0, 0};
+    q.m_mantissa_bits = bits;
+    return q;
+  }
+
+  static quantizer linear(unsigned bits, double min, double max) {
+    if (bits == 0 || bits > 32 || !(min < max)) {
+      throw std::invalid_argument("quantizer: linear needs 1 to 32 bits and min < max");
+    }
+    quantizer q{method::linear, bits, min, max};
+    q.m_step = std::exp2(std::ceil(std::log2((max - min) / std::exp2(bits))));
+    return q;
+  }
+
+  static quantizer log(unsigned bits, double min, double max) {
+    if (!(min > 0) || !(min < max)) {
+      throw std::invalid_argument("quantizer: log needs 0 < min < max");
+    }
+    quantizer q{method::log, bits, min, max};
+    const auto exponents = static_cast<unsigned>(std::ceil(std::log2(max / min))) + 1;
+    const unsigned exponent_bits = std::bit_width(exponents - 1);
+    if (bits < 1 + exponent_bits) {
+      throw std::invalid_argument("quantizer: too few bits for the range of log");
+    }
+    q.m_mantissa_bits = std::min(bits - 1 - exponent_bits, 52u);
+    return q;
+  }
+
+  /// Parse "mantissa:B", "linear:B:MIN:MAX", "log:B:MIN:MAX" or "none"
+  static quantizer from_string(std::string_view spec) {
+    std::vector<std::string> fields;
+    std::istringstream is{std::string(spec)};
+    for (std::string field; std::getline(is, field, ':');) {
+      fields.push_back(field);
+    }
+    try {
+      if (fields.size() == 1 && fields[0] == "none") {
+        return {};
+      }
+      if (fields.size() == 2 && fields[0] == "mantissa") {
+        return mantissa(std::stoul(fields[1]));
+      }
+      if (fields.size() == 4 && fields[0] == "linear") {
+        return linear(std::stoul(fields[1]), std::stod(fields[2]), std::stod(fields[3]));
+      }
+      if (fields.size() == 4 && fields[0] == "log") {
+        return log(std::stoul(fields[1]), std::stod(fields[2]), std::stod(fields[3]));
+      }
+    } catch (const std::logic_error&) {
+    }
+    throw std::invalid_argument("quantizer: invalid specification '" + std::string(spec) + "'");
+  }
+
+  /// Specification as accepted by from_string()
+  std::string to_string() const {
+    std::ostringstream os;
+    os.precision(std::numeric_limits<double>::digits10);
+    switch (m_method) {
+    case method::none:
+      return "none";
+    case method::mantissa:
+      os << "mantissa:" << m_bits;
+      break;
+    case method::linear:
+      os << "linear:" << m_bits << ":" << m_min << ":" << m_max;
+      break;
+    case method::log:
+      os << "log:" << m_bits << ":" << m_min << ":" << m_max;
+      break;
+    }
+    return os.str();
+  }
+
+  method type() const { return m_method; }
+
+  /// Bound on the absolute (linear) or relative (mantissa, log) error within the range
+  double error_bound() const {
+    switch (m_method) {
+    case method::none:
+      return 0;
+    case method::linear:
+      return m_step / 2;
+    default:
+      return std::exp2(-static_cast<double>(m_mantissa_bits) - 1);
+    }
+  }
+
+  template <typename T> T operator()(T value) const {
+    static_assert(std::is_floating_point_v<T>);
+    if (m_method == method::none || !std::isfinite(value)) {
+      return value;
+    }
+    if (m_method == method::linear) {
+      const T clamped = std::clamp(value, static_cast<T>(m_min), static_cast<T>(m_max));
+      return static_cast<T>(std::nearbyint(clamped / m_step) * m_step);
+    }
+    if (m_method == method::log) {
+      // the range is applied after rounding, with rounded bounds, so that
+      // quantized values stay fixed
+      const T magnitude = std::abs(round_mantissa(value, m_mantissa_bits));
+      if (magnitude < round_mantissa(static_cast<T>(m_min), m_mantissa_bits)) {
+        return T{0};
+      }
+      return std::copysign(std::min(magnitude, round_mantissa(static_cast<T>(m_max), m_mantissa_bits)), value);
+    }
+    return round_mantissa(value, m_mantissa_bits);
+  }
+
+private:
+  quantizer(method m, unsigned bits, double min, double max) : m_method{m}, m_bits{bits}, m_min{min}, m_max{max} {}
+
+  // round to nearest even with `bits` explicit mantissa bits
+  template <typename T> static T round_mantissa(T value, unsigned bits) {
+    using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    constexpr unsigned mantissa_bits = std::numeric_limits<T>::digits - 1;
+    if (bits >= mantissa_bits) {
+      return value;
+    }
+    const unsigned drop = mantissa_bits - bits;
+    U u = std::bit_cast<U>(value);
+    u += (U{1} << (drop - 1)) - 1 + ((u >> drop) & 1);
+    u &= ~((U{1} << drop) - 1);
+    return std::bit_cast<T>(u);
+  }
+
+  method m_method{method::none};
+  unsigned m_bits{0};
+  double m_min{0};
+  double m_max{0};
+  double m_step{0};
+  unsigned m_mantissa_bits{0};
+};
+
+/** Quantization of one collection.
+ * Members are grouped by what they describe, so that one setting applies to
+ * e.g. all positions of a hit. Errors and covariances are quantized by the
+ * covariance setting, with the exception of time and energy errors which use
+ * the time and energy settings. The ADC and TDC counts of digitized samples
+ * are quantized as numbers and rounded back to integers, within the range of
+ * their type. Parsed from and recorded as
+ * "position=linear:16:-4096:4096,energy=log:12:1e-6:1e3,...".
+ */
+struct quantization {
+  quantizer position;   // [mm] positions and local coordinates
+  quantizer time;       // [ns] times and their errors
+  quantizer energy;     // [GeV] energies and their errors, and photo-electrons
+  quantizer covariance; // covariance matrix elements
+  quantizer adc;        // [ADC counts] sample amplitudes
+  quantizer tdc;        // [TDC counts] sample times of arrival and over threshold
+
+  static quantization from_string(std::string_view spec) {
+    quantization q;
+    std::istringstream is{std::string(spec)};
+    for (std::string field; std::getline(is, field, ',');) {
+      const auto eq = field.find('=');
+      const auto group = field.substr(0, eq);
+      const auto value = eq == std::string::npos ? std::string{} : field.substr(eq + 1);
+      if (group == "position") {
+        q.position = quantizer::from_string(value);
+      } else if (group == "time") {
+        q.time = quantizer::from_string(value);
+      } else if (group == "energy") {
+        q.energy = quantizer::from_string(value);
+      } else if (group == "covariance") {
+        q.covariance = quantizer::from_string(value);
+      } else if (group == "adc") {
+        q.adc = quantizer::from_string(value);
+      } else if (group == "tdc") {
+        q.tdc = quantizer::from_string(value);
+      } else {
+        throw std::invalid_argument("quantization: invalid member group in '" + field + "'");
+      }
+    }
+    return q;
+  }
+
+  std::string to_string() const {
+    return "position=" + position.to_string() + ",time=" + time.to_string() + ",energy=" + energy.to_string() +
+           ",covariance=" + covariance.to_string() + ",adc=" + adc.to_string() + ",tdc=" + tdc.to_string();
+  }
+};
+
+/// Frame parameter that records the quantization of a collection
+inline std::string quantization_parameter(const std::string& collection) { return collection + "__Quantization"; }
+
+namespace detail {
+
+  template <typename VecT> void quantize_vector(VecT& v, const quantizer& q) {
+    if constexpr (requires { v.a; }) {
+      v.a = q(v.a);
+      v.b = q(v.b);
+    } else {
+      v.x = q(v.x);
+      v.y = q(v.y);
+      if constexpr (requires { v.z; }) {
+        v.z = q(v.z);
+      }
+    }
+  }
+
+  template <typename CovT> void quantize_covariance(CovT& cov, const quantizer& q) {
+    if constexpr (requires { cov.covariance; }) {
+      for (auto& element : cov.covariance) {
+        element = q(element);
+      }
+    } else {
+      // the packed covariances are structs of float members only
+      static_assert(std::is_trivially_copyable_v<CovT> && sizeof(CovT) % sizeof(float) == 0);
+      auto elements = std::bit_cast<std::array<float, sizeof(CovT) / sizeof(float)>>(cov);
+      for (auto& element : elements) {
+        element = q(element);
+      }
+      cov = std::bit_cast<CovT>(elements);
+    }
+  }
+
+  // integer counts, rounded back into the range of their type
+  template <typename IntT> IntT quantize_count(IntT count, const quantizer& q) {
+    const double value = std::nearbyint(q(static_cast<double>(count)));
+    return static_cast<IntT>(std::clamp(value, static_cast<double>(std::numeric_limits<IntT>::min()),
+                                        static_cast<double>(std::numeric_limits<IntT>::max())));
+  }
+
+} // namespace detail
+
+/** Quantization traits.
+ * Apply a quantization to the members of a podio data struct, and to its
+ * VectorMembers, listed in the order of the yaml file. Identifiers, cell
+ * dimensions, track parameters and momenta are never quantized, only their
+ * covariances. Only datatypes with a specialization can be quantized.
+ */
+template <typename DataT> struct quantize_traits;
+
+template <> struct quantize_traits<edm4hep::SimTrackerHitData> {
+  using vector_members = std::tuple<>;
+  static void apply(edm4hep::SimTrackerHitData& data, const quantization& q) {
+    data.eDep = q.energy(data.eDep);
+    data.time = q.time(data.time);
+    detail::quantize_vector(data.position, q.position);
+  }
+};
+
+template <> struct quantize_traits<edm4hep::SimCalorimeterHitData> {
+  using vector_members = std::tuple<>;
+  static void apply(edm4hep::SimCalorimeterHitData& data, const quantization& q) {
+    data.energy = q.energy(data.energy);
+    detail::quantize_vector(data.position, q.position);
+  }
+};
+
+template <> struct quantize_traits<edm4hep::CaloHitContributionData> {
+  using vector_members = std::tuple<>;
+  static void apply(edm4hep::CaloHitContributionData& data, const quantization& q) {
+    data.energy = q.energy(data.energy);
+    data.time = q.time(data.time);
+    detail::quantize_vector(data.stepPosition, q.position);
+  }
+};
+
+template <> struct quantize_traits<edm4eic::CalorimeterHitData> {
+  using vector_members = std::tuple<>;
+  static void apply(edm4eic::CalorimeterHitData& data, const quantization& q) {
+    data.energy = q.energy(data.energy);
+    data.energyError = q.energy(data.energyError);
+    data.time = q.time(data.time);
+    data.timeError = q.time(data.timeError);
+    detail::quantize_vector(data.position, q.position);
+    detail::quantize_vector(data.local, q.position);
+  }
+};
+
+template <> struct quantize_traits<edm4eic::TrackerHitData> {
+  using vector_members = std::tuple<>;
+  static void apply(edm4eic::TrackerHitData& data, const quantization& q) {
+    detail::quantize_vector(data.position, q.position);
+    detail::quantize_covariance(data.positionError, q.covariance);
+    data.time = q.time(data.time);
+    data.timeError = q.time(data.timeError);
+    data.edep = q.energy(data.edep);
+    data.edepError = q.energy(data.edepError);
+  }
+};
+
+template <> struct quantize_traits<edm4eic::PMTHitData> {
+  using vector_members = std::tuple<>;
+  static void apply(edm4eic::PMTHitData& data, const quantization& q) {
+    data.npe = q.energy(data.npe);
+    data.time = q.time(data.time);
+    data.timeError = q.time(data.timeError);
+    detail::quantize_vector(data.position, q.position);
+    detail::quantize_vector(data.local, q.position);
+  }
+};
+
+template <> struct quantize_traits<edm4eic::Measurement2DData> {
+  using vector_members = std::tuple<>;
+  static void apply(edm4eic::Measurement2DData& data, const quantization& q) {
+    detail::quantize_vector(data.loc, q.position);
+    data.time = q.time(data.time);
+    detail::quantize_covariance(data.covariance, q.covariance);
+  }
+};
+
+template <> struct quantize_traits<edm4eic::ClusterData> {
+  using vector_members = std::tuple<>;
+  static void apply(edm4eic::ClusterData& data, const quantization& q) {
+    data.energy = q.energy(data.energy);
+    data.energyError = q.energy(data.energyError);
+    data.time = q.time(data.time);
+    data.timeError = q.time(data.timeError);
+    detail::quantize_vector(data.position, q.position);
+    detail::quantize_covariance(data.positionError, q.covariance);
+    detail::quantize_covariance(data.intrinsicDirectionError, q.covariance);
+  }
+};
+
+template <> struct quantize_traits<edm4eic::VertexData> {
+  using vector_members = std::tuple<>;
+  static void apply(edm4eic::VertexData& data, const quantization& q) {
+    detail::quantize_vector(data.position, q.position);
+    data.position.t = q.time(data.position.t);
+    detail::quantize_covariance(data.positionError, q.covariance);
+  }
+};
+
+template <> struct quantize_traits<edm4eic::TrackParametersData> {
+  using vector_members = std::tuple<>;
+  static void apply(edm4eic::TrackParametersData& data, const quantization& q) {
+    data.time = q.time(data.time);
+    detail::quantize_covariance(data.covariance, q.covariance);
+  }
+};
+
+template <> struct quantize_traits<edm4eic::TrackData> {
+  using vector_members = std::tuple<>;
+  static void apply(edm4eic::TrackData& data, const quantization& q) {
+    detail::quantize_vector(data.position, q.position);
+    detail::quantize_covariance(data.positionMomentumCovariance, q.covariance);
+    data.time = q.time(data.time);
+    data.timeError = q.time(data.timeError);
+  }
+};
+
+template <> struct quantize_traits<edm4eic::RawCALOROCHitData> {
+  using vector_members = std::tuple<edm4eic::CALOROC1ASample, edm4eic::CALOROC1BSample>;
+  static void apply(edm4eic::RawCALOROCHitData&, const quantization&) {}
+  static void apply(std::vector<edm4eic::CALOROC1ASample>& samples, const quantization& q) {
+    for (auto& sample : samples) {
+      sample.ADC = detail::quantize_count(sample.ADC, q.adc);
+      sample.timeOfArrival = detail::quantize_count(sample.timeOfArrival, q.tdc);
+      sample.timeOverThreshold = detail::quantize_count(sample.timeOverThreshold, q.tdc);
+    }
+  }
+  static void apply(std::vector<edm4eic::CALOROC1BSample>& samples, const quantization& q) {
+    for (auto& sample : samples) {
+      sample.lowGainADC = detail::quantize_count(sample.lowGainADC, q.adc);
+      sample.highGainADC = detail::quantize_count(sample.highGainADC, q.adc);
+      sample.timeOfArrival = detail::quantize_count(sample.timeOfArrival, q.tdc);
+    }
+  }
+};
+
+namespace detail {
+
+  template <typename DataT, typename VectorAtT, typename... VecTs, std::size_t... Is>
+  void quantize_vector_members(VectorAtT&& vector_at, const quantization& q, std::tuple<VecTs...>*,
+                               std::index_sequence<Is...>) {
+    (quantize_traits<DataT>::apply(*vector_at.template operator()<VecTs>(Is), q), ...);
+  }
+
+  // `vector_at<T>(i)` returns the VectorMember i of the collection
+  template <typename DataT, typename VectorAtT>
+  void quantize_data(std::vector<DataT>& data, VectorAtT&& vector_at, const quantization& q) {
+    using traits = quantize_traits<DataT>;
+    for (auto& object : data) {
+      traits::apply(object, q);
+    }
+    quantize_vector_members<DataT>(vector_at, q, static_cast<typename traits::vector_members*>(nullptr),
+                                   std::make_index_sequence<std::tuple_size_v<typename traits::vector_members>>{});
+  }
+
+} // namespace detail
+
+/// Quantize all objects in a collection buffer of DataT, as read
+template <typename DataT> void quantize_buffer(podio::CollectionReadBuffers& buffers, const quantization& q) {
+  detail::quantize_data(
+      *static_cast<std::vector<DataT>*>(buffers.data),
+      [&buffers]<typename VecT>(std::size_t i) { return detail::vector_member<VecT>(buffers, i); }, q);
+}
+
+/// Quantize all objects in the write buffers of a collection of DataT, after prepareForWrite()
+template <typename DataT> void quantize_write_buffers(podio::CollectionWriteBuffers& buffers, const quantization& q) {
+  detail::quantize_data(
+      *buffers.dataAsVector<DataT>(),
+      [&buffers]<typename VecT>(std::size_t i) {
+        return podio::CollectionWriteBuffers::asVector<VecT>((*buffers.vectorMembers)[i].second);
+      },
+      q);
+}
+
+/// Type-erased quantization for one collection type
+struct quantize_ops {
+  std::string_view collection_type;
+  void (*apply)(podio::CollectionReadBuffers&, const quantization&);
+  void (*apply_write)(podio::CollectionWriteBuffers&, const quantization&);
+};
+
+namespace detail {
+
+  template <typename CollT, typename DataT> constexpr quantize_ops make_quantize_ops() {
+    return {CollT::typeName, &quantize_buffer<DataT>, &quantize_write_buffers<DataT>};
+  }
+
+} // namespace detail
+
+/// Quantization for a collection type name, if supported
+inline const quantize_ops* find_quantize_ops(std::string_view collection_type) {
+  static constexpr quantize_ops ops[] = {
+      detail::make_quantize_ops<edm4hep::SimTrackerHitCollection, edm4hep::SimTrackerHitData>(),
+      detail::make_quantize_ops<edm4hep::SimCalorimeterHitCollection, edm4hep::SimCalorimeterHitData>(),
+      detail::make_quantize_ops<edm4hep::CaloHitContributionCollection, edm4hep::CaloHitContributionData>(),
+      detail::make_quantize_ops<edm4eic::CalorimeterHitCollection, edm4eic::CalorimeterHitData>(),
+      detail::make_quantize_ops<edm4eic::TrackerHitCollection, edm4eic::TrackerHitData>(),
+      detail::make_quantize_ops<edm4eic::PMTHitCollection, edm4eic::PMTHitData>(),
+      detail::make_quantize_ops<edm4eic::Measurement2DCollection, edm4eic::Measurement2DData>(),
+      detail::make_quantize_ops<edm4eic::ClusterCollection, edm4eic::ClusterData>(),
+      detail::make_quantize_ops<edm4eic::VertexCollection, edm4eic::VertexData>(),
+      detail::make_quantize_ops<edm4eic::TrackParametersCollection, edm4eic::TrackParametersData>(),
+      detail::make_quantize_ops<edm4eic::TrackCollection, edm4eic::TrackData>(),
+      detail::make_quantize_ops<edm4eic::RawCALOROCHitCollection, edm4eic::RawCALOROCHitData>(),
+  };
+  const auto* it = std::find_if(std::begin(ops), std::end(ops),
+                                [&](const auto& op) { return op.collection_type == collection_type; });
+  return it != std::end(ops) ? it : nullptr;
+}
+
+/** Quantize the collection `name` of `frame` and record the settings.
+ * The quantization is stored in the frame parameter
+ * quantization_parameter(name), next to e.g. the cellID encoding of the
+ * collection. Returns false if the collection is not present, is a subset
+ * collection or its type is not supported.
+ */
+inline bool quantize(frame_buffers& frame, const std::string& name, const quantization& q) {
+  auto* buffers = frame.buffers(name);
+  const auto* ops = buffers && buffers->data ? find_quantize_ops(buffers->type) : nullptr;
+  if (ops == nullptr) {
+    return false;
+  }
+  ops->apply(*buffers, q);
+  frame.parameters().set(quantization_parameter(name), q.to_string());
+  return true;
+}
+
+/** Quantize a collection that is about to be written.
+ * The quantization is applied to the write buffers, which prepareForWrite()
+ * fills from the objects only once: the writer serializes the quantized
+ * values, while the objects keep theirs. Changes to the objects after this
+ * call are not written either, so it has to be the last step before
+ * writing. Returns false for subset collections and unsupported types.
+ */
+inline bool quantize(podio::CollectionBase& collection, const quantization& q) {
+  const auto* ops = collection.isSubsetCollection() ? nullptr : find_quantize_ops(collection.getTypeName());
+  if (ops == nullptr) {
+    return false;
+  }
+  collection.prepareForWrite();
+  auto buffers = collection.getBuffers();
+  ops->apply_write(buffers, q);
+  return true;
+}
+
+/** Quantize the collection `name` of a frame right before writeFrame().
+ * E.g. for the output of a reconstruction, where the collections are owned
+ * by the frame: it only hands them out as const, but they are not shared,
+ * and preparing them for writing is what the writer does with them too.
+ * Records the settings as quantize(frame_buffers&, ...) does.
+ */
+inline bool quantize(podio::Frame& frame, const std::string& name, const quantization& q) {
+  const auto* collection = frame.get(name);
+  if (collection == nullptr || !quantize(const_cast<podio::CollectionBase&>(*collection), q)) {
+    return false;
+  }
+  frame.putParameter(quantization_parameter(name), q.to_string());
+  return true;
+}
+
+} // namespace edm4eic
+
+#endif
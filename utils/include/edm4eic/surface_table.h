@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_SURFACE_TABLE_HH
+#define EDM4EIC_UTILS_SURFACE_TABLE_HH
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <podio/Frame.h>
+#include <podio/GenericParameters.h>
+
+#include <edm4eic/Surface.h>
+
+namespace edm4eic {
+
+/** Surface interning table.
+ * Holds every surface once, in contiguous storage, so that per-event
+ * objects only carry the geometry ID (e.g. TrackParameters::surface or
+ * Measurement2D::surface) and resolve the full Surface through the table
+ * without copying it. Indices into the table are stable.
+ *
+ * The table is stored as parameters of a run-level frame, one column per
+ * Surface member under the keys "<name>__<member>": 64-bit IDs are split
+ * into "<member>High" and "<member>Low" int columns, bound values and
+ * transforms are concatenated into one double column each.
+ *
+ * Only surfaces with a geometry ID are interned; dynamic surfaces, e.g.
+ * perigees, have none and must not be referenced by ID.
+ */
+class surface_table {
+public:
+  static constexpr std::size_t bound_values_size = std::tuple_size_v<decltype(edm4eic::Surface::boundValues)>;
+  static constexpr std::size_t transform_size = std::tuple_size_v<decltype(edm4eic::Surface::transform)>;
+
+  surface_table() = default;
+
+  /// Add a surface unless its geometry ID is present, and return its index; the first surface for an ID is kept
+  uint32_t intern(const edm4eic::Surface& surface) {
+    if (surface.geometryId == 0) {
+      throw std::invalid_argument("surface_table: surface without geometry ID");
+    }
+    const auto [it, inserted] = m_index.try_emplace(surface.geometryId, static_cast<uint32_t>(m_surfaces.size()));
+    if (inserted) {
+      m_surfaces.push_back(surface);
+    }
+    return it->second;
+  }
+
+  std::size_t size() const { return m_surfaces.size(); }
+  bool empty() const { return m_surfaces.empty(); }
+
+  const edm4eic::Surface& operator[](uint32_t index) const { return m_surfaces[index]; }
+
+  std::span<const edm4eic::Surface> surfaces() const { return m_surfaces; }
+
+  std::optional<uint32_t> index(uint64_t geometryId) const {
+    const auto it = m_index.find(geometryId);
+    return it != m_index.end() ? std::optional<uint32_t>{it->second} : std::nullopt;
+  }
+
+  /// Surface with a geometry ID, or nullptr
+  const edm4eic::Surface* find(uint64_t geometryId) const {
+    const auto it = m_index.find(geometryId);
+    return it != m_index.end() ? &m_surfaces[it->second] : nullptr;
+  }
+
+  /// Store the table as parameters of e.g. a "runs" frame
+  void write(podio::Frame& frame, const std::string& name = "Surfaces") const {
+    write_columns(name, [&frame](const std::string& key, auto values) { frame.putParameter(key, std::move(values)); });
+  }
+
+  /// Store the table in a set of frame parameters
+  void write(podio::GenericParameters& parameters, const std::string& name = "Surfaces") const {
+    write_columns(name, [&parameters](const std::string& key, auto values) { parameters.set(key, std::move(values)); });
+  }
+
+  /// Read the table from the parameters of a frame, e.g. a "runs" frame
+  static surface_table read(const podio::Frame& frame, const std::string& name = "Surfaces") {
+    return read(frame.getParameters(), name);
+  }
+
+  static surface_table read(const podio::GenericParameters& parameters, const std::string& name = "Surfaces") {
+    const auto surfaceType = column<int>(parameters, name, "surfaceType");
+    const auto boundsType = column<int>(parameters, name, "boundsType");
+    const auto geometryIdHigh = column<int>(parameters, name, "geometryIdHigh");
+    const auto geometryIdLow = column<int>(parameters, name, "geometryIdLow");
+    const auto identifierHigh = column<int>(parameters, name, "identifierHigh");
+    const auto identifierLow = column<int>(parameters, name, "identifierLow");
+    const auto boundValuesSize = column<int>(parameters, name, "boundValuesSize");
+    const auto boundValues = column<double>(parameters, name, "boundValues");
+    const auto transform = column<double>(parameters, name, "transform");
+
+    const std::size_t n = surfaceType.size();
+    if (boundsType.size() != n || geometryIdHigh.size() != n || geometryIdLow.size() != n ||
+        identifierHigh.size() != n || identifierLow.size() != n || boundValuesSize.size() != n ||
+        boundValues.size() != n * bound_values_size || transform.size() != n * transform_size) {
+      throw std::runtime_error("surface_table: inconsistent parameters " + name + "__*");
+    }
+
+    surface_table table;
+    table.m_surfaces.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      edm4eic::Surface surface;
+      surface.surfaceType = surfaceType[i];
+      surface.boundsType = boundsType[i];
+      surface.geometryId = join(geometryIdHigh[i], geometryIdLow[i]);
+      surface.identifier = join(identifierHigh[i], identifierLow[i]);
+      surface.boundValuesSize = static_cast<uint32_t>(boundValuesSize[i]);
+      std::copy_n(boundValues.begin() + i * bound_values_size, bound_values_size, surface.boundValues.begin());
+      std::copy_n(transform.begin() + i * transform_size, transform_size, surface.transform.begin());
+      table.intern(surface);
+    }
+    return table;
+  }
+
+private:
+  template <typename T>
+  static std::vector<T> column(const podio::GenericParameters& parameters, const std::string& name,
+                               const std::string& member) {
+    auto values = parameters.get<std::vector<T>>(name + "__" + member);
+    if (!values) {
+      throw std::runtime_error("surface_table: no parameter " + name + "__" + member);
+    }
+    return std::move(*values);
+  }
+
+  static int high(uint64_t value) { return std::bit_cast<int32_t>(static_cast<uint32_t>(value >> 32)); }
+  static int low(uint64_t value) { return std::bit_cast<int32_t>(static_cast<uint32_t>(value)); }
+  static uint64_t join(int high, int low) {
+    return (uint64_t{std::bit_cast<uint32_t>(int32_t{high})} << 32) | std::bit_cast<uint32_t>(int32_t{low});
+  }
+
+  template <typename SetT> void write_columns(const std::string& name, SetT&& set) const {
+    std::vector<int> surfaceType, boundsType, geometryIdHigh, geometryIdLow, identifierHigh, identifierLow,
+        boundValuesSize;
+    std::vector<double> boundValues, transform;
+    for (const auto& surface : m_surfaces) {
+      surfaceType.push_back(surface.surfaceType);
+      boundsType.push_back(surface.boundsType);
+      geometryIdHigh.push_back(high(surface.geometryId));
+      geometryIdLow.push_back(low(surface.geometryId));
+      identifierHigh.push_back(high(surface.identifier));
+      identifierLow.push_back(low(surface.identifier));
+      boundValuesSize.push_back(static_cast<int>(surface.boundValuesSize));
+      boundValues.insert(boundValues.end(), surface.boundValues.begin(), surface.boundValues.end());
+      transform.insert(transform.end(), surface.transform.begin(), surface.transform.end());
+    }
+    set(name + "__surfaceType", std::move(surfaceType));
+    set(name + "__boundsType", std::move(boundsType));
+    set(name + "__geometryIdHigh", std::move(geometryIdHigh));
+    set(name + "__geometryIdLow", std::move(geometryIdLow));
+    set(name + "__identifierHigh", std::move(identifierHigh));
+    set(name + "__identifierLow", std::move(identifierLow));
+    set(name + "__boundValuesSize", std::move(boundValuesSize));
+    set(name + "__boundValues", std::move(boundValues));
+    set(name + "__transform", std::move(transform));
+  }
+
+  std::vector<edm4eic::Surface> m_surfaces;
+  std::unordered_map<uint64_t, uint32_t> m_index;
+};
+
+} // namespace edm4eic
+
+#endif
@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_TENSOR_UTILS_HH
+#define EDM4EIC_UTILS_TENSOR_UTILS_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <edm4eic/TensorCollection.h>
+
+namespace edm4eic {
+
+/// Element types of a Tensor, in the encoding of ONNXTensorElementDataType
+enum class tensor_element_type : int32_t { float32 = 1, int64 = 7 };
+
+template <typename T> concept TensorElement = std::is_same_v<T, float> || std::is_same_v<T, int64_t>;
+
+template <TensorElement T> constexpr tensor_element_type tensor_element_type_of() {
+  return std::is_same_v<T, float> ? tensor_element_type::float32 : tensor_element_type::int64;
+}
+
+/// Shape and values of a Tensor, referring to its storage
+template <TensorElement T> struct tensor_view {
+  std::span<const int64_t> shape;
+  std::span<const T> data;
+};
+
+namespace detail {
+
+  template <typename RangeT> auto contiguous(const RangeT& range) {
+    using value_type = std::remove_cvref_t<decltype(*range.begin())>;
+    return range.size() > 0 ? std::span<const value_type>{&*range.begin(), range.size()} : std::span<const value_type>{};
+  }
+
+  inline int64_t elements(std::span<const int64_t> shape) {
+    return std::accumulate(shape.begin(), shape.end(), int64_t{1}, std::multiplies<>{});
+  }
+
+} // namespace detail
+
+/** View of the shape and payload of a Tensor, without copying.
+ * VectorMembers are stored contiguously, so the view refers directly to
+ * the storage of the tensor (or of its collection, once read) and is valid
+ * as long as that is. That storage is a std::vector, so the data is only
+ * aligned to alignof(T), and in general does not start at the beginning of
+ * an allocation; inference runtimes that need more get a copy aligned to
+ * tensor_batch::alignment from tensor_batch::add(). Throws if the element
+ * type differs from T or the payload does not match the shape.
+ */
+template <TensorElement T> tensor_view<T> view(const edm4eic::Tensor& tensor) {
+  if (tensor.getElementType() != static_cast<int32_t>(tensor_element_type_of<T>())) {
+    throw std::invalid_argument("edm4eic tensor_utils: tensor has a different element type");
+  }
+  tensor_view<T> v;
+  v.shape = detail::contiguous(tensor.getShape());
+  if constexpr (std::is_same_v<T, float>) {
+    v.data = detail::contiguous(tensor.getFloatData());
+  } else {
+    v.data = detail::contiguous(tensor.getInt64Data());
+  }
+  if (detail::elements(v.shape) != static_cast<int64_t>(v.data.size())) {
+    throw std::invalid_argument("edm4eic tensor_utils: tensor payload does not match its shape");
+  }
+  return v;
+}
+
+/** Batch of events for inference.
+ * Packs a variable number of rows per event, each of a fixed row shape,
+ * into one preallocated buffer of shape [events, max_rows, row shape...],
+ * with padding after the rows of each event and a mask of shape
+ * [events, max_rows] that is 1 for filled rows. data() starts at a
+ * multiple of `alignment` bytes; the events within it are only aligned if
+ * the bytes of max_rows rows are a multiple of it as well. Rows come from a
+ * Tensor of shape [rows, row shape...] or from feature columns, e.g. of
+ * hit_columns. After inference, the output is split into one
+ * TensorCollection per event.
+ *
+ * clear() allows the buffer to be reused for the next batch.
+ */
+template <TensorElement T> class tensor_batch {
+public:
+  static constexpr std::size_t alignment = 64;
+
+  tensor_batch(std::vector<int64_t> row_shape, std::size_t max_events, std::size_t max_rows, T padding = T{0})
+      : m_row_shape{std::move(row_shape)}
+      , m_row_size{static_cast<std::size_t>(detail::elements(m_row_shape))}
+      , m_max_events{max_events}
+      , m_max_rows{max_rows}
+      , m_padding{padding}
+      , m_data{allocate(max_events * max_rows * m_row_size)}
+      , m_mask(max_events * max_rows, 0) {
+    std::fill_n(m_data.get(), max_events * max_rows * m_row_size, m_padding);
+  }
+
+  std::size_t events() const { return m_rows.size(); }
+  std::size_t rows(std::size_t event) const { return m_rows[event]; }
+  bool full() const { return m_rows.size() == m_max_events; }
+
+  /// Shape of data(), with the number of events added so far
+  std::vector<int64_t> shape() const {
+    std::vector<int64_t> s{static_cast<int64_t>(events()), static_cast<int64_t>(m_max_rows)};
+    s.insert(s.end(), m_row_shape.begin(), m_row_shape.end());
+    return s;
+  }
+
+  std::span<const T> data() const { return {m_data.get(), events() * m_max_rows * m_row_size}; }
+  std::span<T> data() { return {m_data.get(), events() * m_max_rows * m_row_size}; }
+  std::span<const uint8_t> mask() const { return {m_mask.data(), events() * m_max_rows}; }
+
+  /// Add an event with `values` of `rows` rows in row-major order; returns its index in the batch
+  std::size_t add_rows(std::span<const T> values, std::size_t rows) {
+    T* row = begin_event(rows);
+    if (values.size() != rows * m_row_size) {
+      throw std::invalid_argument("edm4eic tensor_utils: values do not match the rows");
+    }
+    std::copy(values.begin(), values.end(), row);
+    return end_event(rows);
+  }
+
+  /// Add an event from a Tensor of shape [rows, row shape...]
+  std::size_t add(const edm4eic::Tensor& tensor) {
+    const auto v = view<T>(tensor);
+    if (v.shape.empty() || !std::equal(v.shape.begin() + 1, v.shape.end(), m_row_shape.begin(), m_row_shape.end())) {
+      throw std::invalid_argument("edm4eic tensor_utils: tensor does not match the row shape");
+    }
+    return add_rows(v.data, static_cast<std::size_t>(v.shape[0]));
+  }
+
+  /// Add an event from feature columns of equal length, one per element of a flat row
+  std::size_t add_columns(std::span<const std::span<const T>> columns) {
+    if (columns.size() != m_row_size) {
+      throw std::invalid_argument("edm4eic tensor_utils: columns do not match the row size");
+    }
+    const std::size_t rows = columns.empty() ? 0 : columns[0].size();
+    T* out = begin_event(rows);
+    for (std::size_t c = 0; c < columns.size(); ++c) {
+      if (columns[c].size() != rows) {
+        throw std::invalid_argument("edm4eic tensor_utils: columns of different length");
+      }
+      for (std::size_t r = 0; r < rows; ++r) {
+        out[r * m_row_size + c] = columns[c][r];
+      }
+    }
+    return end_event(rows);
+  }
+
+  /// Reset the filled part of the buffer to padding, for the next batch
+  void clear() {
+    std::fill_n(m_data.get(), events() * m_max_rows * m_row_size, m_padding);
+    std::fill_n(m_mask.begin(), events() * m_max_rows, 0);
+    m_rows.clear();
+  }
+
+  /** Split a per-row output of shape [events, max_rows, output row shape...].
+   * Each event gets a Tensor of shape [rows, output row shape...] with its
+   * filled rows only.
+   */
+  template <TensorElement U>
+  std::vector<edm4eic::TensorCollection> split_rows(std::span<const U> output, std::span<const int64_t> row_shape) const {
+    const auto row_size = static_cast<std::size_t>(detail::elements(row_shape));
+    if (output.size() != events() * m_max_rows * row_size) {
+      throw std::invalid_argument("edm4eic tensor_utils: output does not match the batch");
+    }
+    std::vector<edm4eic::TensorCollection> tensors(events());
+    for (std::size_t e = 0; e < events(); ++e) {
+      std::vector<int64_t> shape{static_cast<int64_t>(m_rows[e])};
+      shape.insert(shape.end(), row_shape.begin(), row_shape.end());
+      make_tensor(tensors[e], shape, output.subspan(e * m_max_rows * row_size, m_rows[e] * row_size));
+    }
+    return tensors;
+  }
+
+  /// Split a per-event output of shape [events, output shape...]
+  template <TensorElement U>
+  std::vector<edm4eic::TensorCollection> split_events(std::span<const U> output, std::span<const int64_t> shape) const {
+    const auto size = static_cast<std::size_t>(detail::elements(shape));
+    if (output.size() != events() * size) {
+      throw std::invalid_argument("edm4eic tensor_utils: output does not match the batch");
+    }
+    std::vector<edm4eic::TensorCollection> tensors(events());
+    for (std::size_t e = 0; e < events(); ++e) {
+      make_tensor(tensors[e], shape, output.subspan(e * size, size));
+    }
+    return tensors;
+  }
+
+private:
+  struct aligned_delete {
+    void operator()(T* p) const { ::operator delete[](p, std::align_val_t{alignment}); }
+  };
+
+  static std::unique_ptr<T[], aligned_delete> allocate(std::size_t n) {
+    return std::unique_ptr<T[], aligned_delete>{
+        static_cast<T*>(::operator new[](std::max<std::size_t>(n, 1) * sizeof(T), std::align_val_t{alignment}))};
+  }
+
+  T* begin_event(std::size_t rows) {
+    if (full()) {
+      throw std::length_error("edm4eic tensor_utils: batch is full");
+    }
+    if (rows > m_max_rows) {
+      throw std::length_error("edm4eic tensor_utils: event has more rows than the batch");
+    }
+    return m_data.get() + events() * m_max_rows * m_row_size;
+  }
+
+  std::size_t end_event(std::size_t rows) {
+    std::fill_n(m_mask.begin() + static_cast<std::ptrdiff_t>(events() * m_max_rows), rows, 1);
+    m_rows.push_back(rows);
+    return m_rows.size() - 1;
+  }
+
+  template <TensorElement U>
+  static void make_tensor(edm4eic::TensorCollection& collection, std::span<const int64_t> shape,
+                          std::span<const U> values) {
+    auto tensor = collection.create();
+    tensor.setElementType(static_cast<int32_t>(tensor_element_type_of<U>()));
+    for (const auto length : shape) {
+      tensor.addToShape(length);
+    }
+    for (const auto value : values) {
+      if constexpr (std::is_same_v<U, float>) {
+        tensor.addToFloatData(value);
+      } else {
+        tensor.addToInt64Data(value);
+      }
+    }
+  }
+
+  std::vector<int64_t> m_row_shape;
+  std::size_t m_row_size;
+  std::size_t m_max_events;
+  std::size_t m_max_rows;
+  T m_padding;
+  std::unique_ptr<T[], aligned_delete> m_data;
+  std::vector<uint8_t> m_mask;
+  std::vector<std::size_t> m_rows;
+};
+
+} // namespace edm4eic
+
+#endif
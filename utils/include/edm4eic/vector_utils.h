@@ -9,7 +9,14 @@
 #if !__cpp_concepts
 #include <edm4eic/vector_utils_legacy.h>
 #else
+#include <bit>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
 
 #include <edm4hep/Vector3f.h>
 
@@ -116,6 +123,186 @@ template <Vector3D V> double projection(const V& v, const V& v1) {
   return v * v1 / norm;
 }
 
+// Batch versions of the kinematic helpers.
+// These take either a contiguous range of vectors or x/y/z columns and write
+// one value per vector into a caller-provided output span of the same size.
+// The loops are kept free of branches so that they auto-vectorize (with GCC
+// this needs -fno-math-errno and -fno-trapping-math). All intermediate values
+// are doubles, so the results are at least as precise as the single-vector
+// versions, which evaluate std::hypot in float for float vectors.
+namespace detail {
+
+template <typename... Sizes> void check_batch_sizes(std::size_t n, Sizes... sizes) {
+  if (((sizes != n) || ...)) {
+    throw std::invalid_argument("edm4eic vector_utils: inconsistent batch sizes");
+  }
+}
+
+inline double anglePolar_xyz(const double x, const double y, const double z) {
+  return std::atan2(std::sqrt(x * x + y * y), z);
+}
+// -log(tan(theta/2)) == sign(z) * log((|p| + |z|) / pt), without cancellation
+inline double eta_xyz(const double x, const double y, const double z) {
+  const double pt = std::sqrt(x * x + y * y);
+  const double p = std::sqrt(x * x + y * y + z * z);
+  const double eta = std::copysign(std::log((p + std::fabs(z)) / pt), z);
+  return pt > 0 ? eta : std::copysign(std::numeric_limits<double>::infinity(), z);
+}
+inline double magnitude_xyz(const double x, const double y, const double z) {
+  return std::sqrt(x * x + y * y + z * z);
+}
+
+template <typename R>
+concept Vector3DRange =
+    std::ranges::contiguous_range<R> && Vector3D<std::ranges::range_value_t<R>>;
+
+} // namespace detail
+
+template <detail::Vector3DRange R> void anglePolar(const R& v, std::span<double> out) {
+  detail::check_batch_sizes(std::ranges::size(v), out.size());
+  const auto* in = std::ranges::data(v);
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = detail::anglePolar_xyz(vector_x(in[i]), vector_y(in[i]), vector_z(in[i]));
+  }
+}
+inline void anglePolar(std::span<const float> x, std::span<const float> y,
+                       std::span<const float> z, std::span<double> out) {
+  detail::check_batch_sizes(out.size(), x.size(), y.size(), z.size());
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = detail::anglePolar_xyz(x[i], y[i], z[i]);
+  }
+}
+// Along the beam axis (pt == 0) the batched eta is +-infinity by the sign of z.
+// The single-vector eta goes through the polar angle instead: it gives
+// +infinity along +z, but -log(tan(pi / 2)) along -z, which is about -37 for
+// double vectors and NaN for float vectors.
+template <detail::Vector3DRange R> void eta(const R& v, std::span<double> out) {
+  detail::check_batch_sizes(std::ranges::size(v), out.size());
+  const auto* in = std::ranges::data(v);
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = detail::eta_xyz(vector_x(in[i]), vector_y(in[i]), vector_z(in[i]));
+  }
+}
+inline void eta(std::span<const float> x, std::span<const float> y, std::span<const float> z,
+                std::span<double> out) {
+  detail::check_batch_sizes(out.size(), x.size(), y.size(), z.size());
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = detail::eta_xyz(x[i], y[i], z[i]);
+  }
+}
+template <detail::Vector3DRange R> void magnitude(const R& v, std::span<double> out) {
+  detail::check_batch_sizes(std::ranges::size(v), out.size());
+  const auto* in = std::ranges::data(v);
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = detail::magnitude_xyz(vector_x(in[i]), vector_y(in[i]), vector_z(in[i]));
+  }
+}
+inline void magnitude(std::span<const float> x, std::span<const float> y,
+                      std::span<const float> z, std::span<double> out) {
+  detail::check_batch_sizes(out.size(), x.size(), y.size(), z.size());
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = detail::magnitude_xyz(x[i], y[i], z[i]);
+  }
+}
+// Project every vector of v onto the axis v1
+template <detail::Vector3DRange R, Vector3D V>
+void projection(const R& v, const V& v1, std::span<double> out) {
+  detail::check_batch_sizes(std::ranges::size(v), out.size());
+  const auto* in = std::ranges::data(v);
+  const double norm = magnitude(v1);
+  if (norm == 0) {
+    magnitude(v, out);
+    return;
+  }
+  const double ux = vector_x(v1) / norm;
+  const double uy = vector_y(v1) / norm;
+  const double uz = vector_z(v1) / norm;
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = vector_x(in[i]) * ux + vector_y(in[i]) * uy + vector_z(in[i]) * uz;
+  }
+}
+template <Vector3D V>
+void projection(std::span<const float> x, std::span<const float> y, std::span<const float> z,
+                const V& v1, std::span<double> out) {
+  detail::check_batch_sizes(out.size(), x.size(), y.size(), z.size());
+  const double norm = magnitude(v1);
+  if (norm == 0) {
+    magnitude(x, y, z, out);
+    return;
+  }
+  const double ux = vector_x(v1) / norm;
+  const double uy = vector_y(v1) / norm;
+  const double uz = vector_z(v1) / norm;
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = x[i] * ux + y[i] * uy + z[i] * uz;
+  }
+}
+
+// Opt-in fast tier: single-precision kernels with a polynomial logarithm.
+// Intended for selections and histogramming, not for reconstruction inputs.
+namespace fast {
+
+/** Natural logarithm of a positive, finite, normal float.
+ * Cephes logf polynomial on the mantissa reduced to [sqrt(1/2), sqrt(2)),
+ * maximum relative error 2e-7. Branch-free so that loops vectorize.
+ */
+inline float log(const float x) {
+  const auto bits = std::bit_cast<uint32_t>(x);
+  int32_t e = static_cast<int32_t>(bits >> 23) - 127;
+  float m = std::bit_cast<float>((bits & 0x007fffffu) | 0x3f800000u); // [1, 2)
+  const bool big = m > 1.41421356f;
+  m = big ? 0.5f * m : m;
+  e += big ? 1 : 0;
+  const float f = m - 1.f;
+  const float f2 = f * f;
+  float poly = 7.0376836292e-2f;
+  poly = poly * f - 1.1514610310e-1f;
+  poly = poly * f + 1.1676998740e-1f;
+  poly = poly * f - 1.2420140846e-1f;
+  poly = poly * f + 1.4249322787e-1f;
+  poly = poly * f - 1.6668057665e-1f;
+  poly = poly * f + 2.0000714765e-1f;
+  poly = poly * f - 2.4999993993e-1f;
+  poly = poly * f + 3.3333331174e-1f;
+  const float r = f + f2 * (f * poly - 0.5f);
+  return r + static_cast<float>(e) * 0.693147180559945f;
+}
+
+/** Pseudorapidity from pz and |p|.
+ * sign(z) * log((|p| + |z|) / pt) in single precision. The maximum absolute
+ * error with respect to the batched edm4eic::eta, which is evaluated in double
+ * precision, is below 2e-6 for |eta| < 10; vectors along
+ * the beam axis (pt == 0) give +-infinity as in the batched version, unlike
+ * the single-vector edm4eic::eta, which is NaN along -z for float vectors.
+ */
+inline float eta(const float x, const float y, const float z) {
+  const float pt2 = x * x + y * y;
+  const float p = std::sqrt(pt2 + z * z);
+  const float pt = std::sqrt(pt2);
+  const float ratio = (p + std::fabs(z)) / (pt2 > 0 ? pt : 1.f);
+  const float eta = std::copysign(fast::log(ratio), z);
+  return pt2 > 0 ? eta : std::copysign(std::numeric_limits<float>::infinity(), z);
+}
+template <Vector3D V> float eta(const V& v) {
+  return fast::eta(vector_x(v), vector_y(v), vector_z(v));
+}
+template <detail::Vector3DRange R> void eta(const R& v, std::span<float> out) {
+  detail::check_batch_sizes(std::ranges::size(v), out.size());
+  const auto* in = std::ranges::data(v);
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = fast::eta(vector_x(in[i]), vector_y(in[i]), vector_z(in[i]));
+  }
+}
+inline void eta(std::span<const float> x, std::span<const float> y, std::span<const float> z,
+                std::span<float> out) {
+  detail::check_batch_sizes(out.size(), x.size(), y.size(), z.size());
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = fast::eta(x[i], y[i], z[i]);
+  }
+}
+
+} // namespace fast
+
 template <edm4eic::Vector2D V> V operator+(const V& v1, const V& v2) {
   return {edm4eic::vector_x(v1) + edm4eic::vector_x(v2),
           edm4eic::vector_y(v1) + edm4eic::vector_y(v2)};
@@ -0,0 +1,294 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#ifndef EDM4EIC_UTILS_WAVEFORM_UTILS_HH
+#define EDM4EIC_UTILS_WAVEFORM_UTILS_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <edm4eic/RawCALOROCHitCollection.h>
+#include <edm4eic/SimPulseCollection.h>
+
+namespace edm4eic {
+
+/** Waveform samples of all hits of a collection, in columns.
+ * The samples of hit i are [offsets[i], offsets[i + 1]) in every column, so
+ * that the kernels below stream over one packed array per sample field
+ * instead of visiting the VectorMembers of every hit. The maxima, sums and
+ * differences over the samples of a hit are plain loops that the compiler
+ * can vectorize; the searches for the peak index or the first non-zero sample
+ * stop at their match and are not vectorized.
+ */
+struct caloroc1a_samples {
+  std::vector<uint32_t> offsets{0};
+  std::vector<uint16_t> adc;
+  std::vector<uint16_t> toa;
+  std::vector<uint16_t> tot;
+
+  std::size_t hits() const { return offsets.size() - 1; }
+};
+
+struct caloroc1b_samples {
+  std::vector<uint32_t> offsets{0};
+  std::vector<uint16_t> low_gain;
+  std::vector<uint16_t> high_gain;
+  std::vector<uint16_t> toa;
+
+  std::size_t hits() const { return offsets.size() - 1; }
+};
+
+struct pulse_samples {
+  std::vector<uint32_t> offsets{0};
+  std::vector<float> amplitude;
+  std::vector<float> start;    // [ns] per pulse
+  std::vector<float> interval; // [ns] per pulse
+
+  std::size_t hits() const { return offsets.size() - 1; }
+};
+
+/// CALOROC1A samples of all hits
+inline caloroc1a_samples caloroc1a_columns(const RawCALOROCHitCollection& hits) {
+  caloroc1a_samples samples;
+  samples.offsets.reserve(hits.size() + 1);
+  for (const auto& hit : hits) {
+    for (const auto& sample : hit.getASamples()) {
+      samples.adc.push_back(sample.ADC);
+      samples.toa.push_back(sample.timeOfArrival);
+      samples.tot.push_back(sample.timeOverThreshold);
+    }
+    samples.offsets.push_back(static_cast<uint32_t>(samples.adc.size()));
+  }
+  return samples;
+}
+
+/// CALOROC1B samples of all hits
+inline caloroc1b_samples caloroc1b_columns(const RawCALOROCHitCollection& hits) {
+  caloroc1b_samples samples;
+  samples.offsets.reserve(hits.size() + 1);
+  for (const auto& hit : hits) {
+    for (const auto& sample : hit.getBSamples()) {
+      samples.low_gain.push_back(sample.lowGainADC);
+      samples.high_gain.push_back(sample.highGainADC);
+      samples.toa.push_back(sample.timeOfArrival);
+    }
+    samples.offsets.push_back(static_cast<uint32_t>(samples.low_gain.size()));
+  }
+  return samples;
+}
+
+/// Amplitudes of all pulses
+inline pulse_samples pulse_columns(const SimPulseCollection& pulses) {
+  pulse_samples samples;
+  samples.offsets.reserve(pulses.size() + 1);
+  samples.start.reserve(pulses.size());
+  samples.interval.reserve(pulses.size());
+  for (const auto& pulse : pulses) {
+    const auto amplitude = pulse.getAmplitude();
+    samples.amplitude.insert(samples.amplitude.end(), amplitude.begin(), amplitude.end());
+    samples.offsets.push_back(static_cast<uint32_t>(samples.amplitude.size()));
+    samples.start.push_back(pulse.getTime());
+    samples.interval.push_back(pulse.getInterval());
+  }
+  return samples;
+}
+
+/// Sample index of hits without a matching sample
+inline constexpr uint32_t no_sample = std::numeric_limits<uint32_t>::max();
+
+namespace detail {
+
+  inline void check_waveform_sizes(std::span<const uint32_t> offsets, std::size_t samples, std::size_t hits) {
+    if (offsets.empty() || offsets.back() != samples || offsets.size() - 1 != hits) {
+      throw std::invalid_argument("edm4eic waveform_utils: inconsistent batch sizes");
+    }
+  }
+
+} // namespace detail
+
+/// Maximum sample of every hit, and its index within the hit (first one if repeated, no_sample if empty)
+template <typename T>
+void peak(std::span<const uint32_t> offsets, std::span<const T> samples, std::span<T> value,
+          std::span<uint32_t> sample) {
+  detail::check_waveform_sizes(offsets, samples.size(), value.size());
+  detail::check_waveform_sizes(offsets, samples.size(), sample.size());
+  for (std::size_t i = 0; i < value.size(); ++i) {
+    const auto* s = samples.data() + offsets[i];
+    const uint32_t n = offsets[i + 1] - offsets[i];
+    T max = n > 0 ? s[0] : T{0};
+    for (uint32_t j = 1; j < n; ++j) {
+      max = std::max(max, s[j]);
+    }
+    value[i] = max;
+    sample[i] = n > 0 ? static_cast<uint32_t>(std::find(s, s + n, max) - s) : no_sample;
+  }
+}
+
+/// Mean of the first `count` samples of every hit, e.g. as a pedestal (0 for hits without samples)
+inline void leading_mean(std::span<const uint32_t> offsets, std::span<const uint16_t> samples, uint32_t count,
+                         std::span<float> mean) {
+  detail::check_waveform_sizes(offsets, samples.size(), mean.size());
+  for (std::size_t i = 0; i < mean.size(); ++i) {
+    const auto* s = samples.data() + offsets[i];
+    const uint32_t n = std::min(count, offsets[i + 1] - offsets[i]);
+    uint32_t sum = 0;
+    for (uint32_t j = 0; j < n; ++j) {
+      sum += s[j];
+    }
+    mean[i] = n > 0 ? static_cast<float>(sum) / static_cast<float>(n) : 0.f;
+  }
+}
+
+/// Samples minus the pedestal of their hit
+inline void subtract_pedestal(std::span<const uint32_t> offsets, std::span<const uint16_t> samples,
+                              std::span<const float> pedestal, std::span<float> out) {
+  detail::check_waveform_sizes(offsets, samples.size(), pedestal.size());
+  if (out.size() != samples.size()) {
+    throw std::invalid_argument("edm4eic waveform_utils: inconsistent batch sizes");
+  }
+  for (std::size_t i = 0; i < pedestal.size(); ++i) {
+    const auto* s = samples.data() + offsets[i];
+    auto* o = out.data() + offsets[i];
+    const uint32_t n = offsets[i + 1] - offsets[i];
+    const float p = pedestal[i];
+    for (uint32_t j = 0; j < n; ++j) {
+      o[j] = static_cast<float>(s[j]) - p;
+    }
+  }
+}
+
+/// First non-zero sample of every hit, e.g. a TOA or TOT, and its index within the hit (no_sample and 0 if none)
+inline void first_nonzero(std::span<const uint32_t> offsets, std::span<const uint16_t> samples,
+                          std::span<uint32_t> sample, std::span<uint16_t> value) {
+  detail::check_waveform_sizes(offsets, samples.size(), sample.size());
+  detail::check_waveform_sizes(offsets, samples.size(), value.size());
+  for (std::size_t i = 0; i < sample.size(); ++i) {
+    const auto* s = samples.data() + offsets[i];
+    const uint32_t n = offsets[i + 1] - offsets[i];
+    const auto* it = std::find_if(s, s + n, [](uint16_t v) { return v != 0; });
+    sample[i] = it != s + n ? static_cast<uint32_t>(it - s) : no_sample;
+    value[i] = it != s + n ? *it : uint16_t{0};
+  }
+}
+
+/** Per-hit waveform features.
+ * Times of CALOROC hits are relative to their first sample. The gain flag is 1 if
+ * the amplitude was taken from the TOT (CALOROC1A) or the low gain
+ * (CALOROC1B) and 0 otherwise.
+ */
+struct waveform_hits {
+  std::vector<float> amplitude;
+  std::vector<float> time;
+  std::vector<uint8_t> gain;
+
+  explicit waveform_hits(std::size_t hits) : amplitude(hits), time(hits), gain(hits) {}
+};
+
+struct caloroc1a_settings {
+  float pedestal{0};            // [ADC counts], unless estimated
+  uint32_t pedestal_samples{0}; // estimate the pedestal from this many leading samples if non-zero
+  float tot_scale{1};           // [ADC counts] per TOT count, for saturated hits
+  float sample_period{25};      // [ns]
+  float toa_lsb{25.f / 1024};   // [ns] per TOA count
+};
+
+/** Amplitude and time of CALOROC1A hits.
+ * The amplitude is the peak ADC minus the pedestal, or the first non-zero
+ * TOT scaled by tot_scale for hits whose ADC saturated. The time is given
+ * by the first sample with a TOA, or by the peak sample if there is none.
+ * Hits without samples have amplitude and time 0.
+ */
+inline waveform_hits reconstruct(const caloroc1a_samples& samples, const caloroc1a_settings& settings) {
+  const std::size_t n = samples.hits();
+  waveform_hits out{n};
+  std::vector<uint16_t> adc_peak(n), toa(n), tot(n);
+  std::vector<uint32_t> adc_sample(n), toa_sample(n), tot_sample(n);
+  std::vector<float> pedestal(n, settings.pedestal);
+  peak<uint16_t>(samples.offsets, samples.adc, adc_peak, adc_sample);
+  first_nonzero(samples.offsets, samples.toa, toa_sample, toa);
+  first_nonzero(samples.offsets, samples.tot, tot_sample, tot);
+  if (settings.pedestal_samples > 0) {
+    leading_mean(samples.offsets, samples.adc, settings.pedestal_samples, pedestal);
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    const bool saturated = tot_sample[i] != no_sample;
+    out.amplitude[i] = saturated                   ? tot[i] * settings.tot_scale
+                       : adc_sample[i] != no_sample ? adc_peak[i] - pedestal[i]
+                                                    : 0.f;
+    out.gain[i] = saturated ? 1 : 0;
+    out.time[i] = toa_sample[i] != no_sample ? toa_sample[i] * settings.sample_period + toa[i] * settings.toa_lsb
+                  : adc_sample[i] != no_sample ? adc_sample[i] * settings.sample_period
+                                               : 0.f;
+  }
+  return out;
+}
+
+struct caloroc1b_settings {
+  float pedestal_low{0};       // [ADC counts] low gain
+  float pedestal_high{0};      // [ADC counts] high gain
+  float gain_ratio{1};         // high gain over low gain
+  uint16_t saturation{1023};   // [ADC counts] high gain peak at which the low gain is used
+  float sample_period{25};     // [ns]
+  float toa_lsb{25.f / 1024};  // [ns] per TOA count
+};
+
+/** Amplitude and time of CALOROC1B hits, in high gain ADC counts.
+ * The high gain peak is used unless it reaches the saturation, in which case
+ * the low gain peak is scaled by gain_ratio. The time is given by the first
+ * sample with a TOA, or by the peak sample of the selected gain. Hits
+ * without samples have amplitude and time 0.
+ */
+inline waveform_hits reconstruct(const caloroc1b_samples& samples, const caloroc1b_settings& settings) {
+  const std::size_t n = samples.hits();
+  waveform_hits out{n};
+  std::vector<uint16_t> low_peak(n), high_peak(n), toa(n);
+  std::vector<uint32_t> low_sample(n), high_sample(n), toa_sample(n);
+  peak<uint16_t>(samples.offsets, samples.low_gain, low_peak, low_sample);
+  peak<uint16_t>(samples.offsets, samples.high_gain, high_peak, high_sample);
+  first_nonzero(samples.offsets, samples.toa, toa_sample, toa);
+  for (std::size_t i = 0; i < n; ++i) {
+    const bool empty = high_sample[i] == no_sample;
+    const bool low = !empty && high_peak[i] >= settings.saturation;
+    out.amplitude[i] = empty ? 0.f
+                       : low ? (low_peak[i] - settings.pedestal_low) * settings.gain_ratio
+                             : high_peak[i] - settings.pedestal_high;
+    out.gain[i] = low ? 1 : 0;
+    const uint32_t peak_sample = low ? low_sample[i] : high_sample[i];
+    out.time[i] = toa_sample[i] != no_sample ? toa_sample[i] * settings.sample_period + toa[i] * settings.toa_lsb
+                  : peak_sample != no_sample ? peak_sample * settings.sample_period
+                                             : 0.f;
+  }
+  return out;
+}
+
+/** Peak amplitude and time of simulated pulses.
+ * The time of the maximum is refined by a parabola through the peak sample
+ * and its neighbours, and is absolute, i.e. includes the pulse start time.
+ */
+inline waveform_hits reconstruct(const pulse_samples& samples) {
+  const std::size_t n = samples.hits();
+  waveform_hits out{n};
+  std::vector<uint32_t> peak_sample(n);
+  peak<float>(samples.offsets, samples.amplitude, out.amplitude, peak_sample);
+  for (std::size_t i = 0; i < n; ++i) {
+    const uint32_t k = peak_sample[i];
+    const uint32_t size = samples.offsets[i + 1] - samples.offsets[i];
+    float delta = 0;
+    if (k != no_sample && k > 0 && k + 1 < size) {
+      const float* a = samples.amplitude.data() + samples.offsets[i] + k;
+      const float curvature = a[-1] - 2 * a[0] + a[1];
+      delta = curvature < 0 ? 0.5f * (a[-1] - a[1]) / curvature : 0.f;
+    }
+    out.time[i] = samples.start[i] + (k != no_sample ? (k + delta) * samples.interval[i] : 0.f);
+  }
+  return out;
+}
+
+} // namespace edm4eic
+
+#endif
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+#include <edm4eic/analysis_utils.h>
+#include <edm4eic/dataframe.h>
+#include <edm4eic/vector_utils.h>
+
+namespace edm4eic::rdf {
+
+namespace {
+
+  // momentum of a track, zero for |qOverP| < 1e-9
+  inline double track_momentum(const edm4eic::TrackParametersData& track) {
+    const double a = std::fabs(track.qOverP);
+    return a < 1e-9 ? 0. : 1. / a;
+  }
+
+  template <typename T, typename F> RVec<float> transform(const RVec<T>& in, F&& f) {
+    RVec<float> out(in.size());
+    for (std::size_t i = 0; i < in.size(); ++i) {
+      out[i] = static_cast<float>(f(in[i]));
+    }
+    return out;
+  }
+
+} // namespace
+
+RVec<float> p(const RVec<edm4eic::ReconstructedParticleData>& particles) {
+  return transform(particles, [](const auto& particle) {
+    const auto& m = particle.momentum;
+    return edm4eic::detail::magnitude_xyz(m.x, m.y, m.z);
+  });
+}
+
+RVec<float> pt(const RVec<edm4eic::ReconstructedParticleData>& particles) {
+  return transform(particles, [](const auto& particle) {
+    const double x = particle.momentum.x, y = particle.momentum.y;
+    return std::sqrt(x * x + y * y);
+  });
+}
+
+RVec<float> theta(const RVec<edm4eic::ReconstructedParticleData>& particles) {
+  return transform(particles, [](const auto& particle) {
+    const auto& m = particle.momentum;
+    return edm4eic::detail::anglePolar_xyz(m.x, m.y, m.z);
+  });
+}
+
+RVec<float> phi(const RVec<edm4eic::ReconstructedParticleData>& particles) {
+  return transform(particles,
+                   [](const auto& particle) { return std::atan2(particle.momentum.y, particle.momentum.x); });
+}
+
+RVec<float> eta(const RVec<edm4eic::ReconstructedParticleData>& particles) {
+  return transform(particles, [](const auto& particle) {
+    const auto& m = particle.momentum;
+    return edm4eic::detail::eta_xyz(m.x, m.y, m.z);
+  });
+}
+
+RVec<float> rapidity(const RVec<edm4eic::ReconstructedParticleData>& particles) {
+  return transform(particles, [](const auto& particle) {
+    const double e = particle.energy, pz = particle.momentum.z;
+    return 0.5 * std::log((e + pz) / (e - pz));
+  });
+}
+
+RVec<ROOT::Math::PxPyPzEVector> momenta(const RVec<edm4eic::ReconstructedParticleData>& particles) {
+  RVec<ROOT::Math::PxPyPzEVector> out(particles.size());
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    const auto& m = particles[i].momentum;
+    out[i] = ROOT::Math::PxPyPzEVector{m.x, m.y, m.z, particles[i].energy};
+  }
+  return out;
+}
+
+RVec<float> track_p(const RVec<edm4eic::TrackParametersData>& tracks) {
+  return transform(tracks, track_momentum);
+}
+
+RVec<float> track_pt(const RVec<edm4eic::TrackParametersData>& tracks) {
+  return transform(tracks, [](const auto& track) { return track_momentum(track) * std::sin(track.theta); });
+}
+
+RVec<float> track_eta(const RVec<edm4eic::TrackParametersData>& tracks) {
+  return transform(tracks, [](const auto& track) { return edm4eic::angleToEta(track.theta); });
+}
+
+RVec<ROOT::Math::PxPyPzMVector> track_momenta(const RVec<edm4eic::TrackParametersData>& tracks, const double mass) {
+  const std::size_t n = tracks.size();
+  RVec<float> theta(n), phi(n), qOverP(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    theta[i] = tracks[i].theta;
+    phi[i] = tracks[i].phi;
+    qOverP[i] = tracks[i].qOverP;
+  }
+  RVec<double> px(n), py(n), pz(n), energy(n);
+  edm4eic::momenta_from_tracking(std::span<const float>{theta.data(), n}, std::span<const float>{phi.data(), n},
+                                 std::span<const float>{qOverP.data(), n}, mass, std::span<double>{px.data(), n},
+                                 std::span<double>{py.data(), n}, std::span<double>{pz.data(), n},
+                                 std::span<double>{energy.data(), n});
+  RVec<ROOT::Math::PxPyPzMVector> out(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = ROOT::Math::PxPyPzMVector{px[i], py[i], pz[i], mass};
+  }
+  return out;
+}
+
+RVec<float> cluster_eta(const RVec<edm4eic::ClusterData>& clusters) {
+  return transform(clusters, [](const auto& cluster) {
+    const auto& x = cluster.position;
+    return edm4eic::detail::eta_xyz(x.x, x.y, x.z);
+  });
+}
+
+RVec<float> cluster_phi(const RVec<edm4eic::ClusterData>& clusters) {
+  return transform(clusters,
+                   [](const auto& cluster) { return std::atan2(cluster.position.y, cluster.position.x); });
+}
+
+float cluster_energy_sum(const RVec<edm4eic::ClusterData>& clusters) {
+  double sum = 0;
+  for (const auto& cluster : clusters) {
+    sum += cluster.energy;
+  }
+  return static_cast<float>(sum);
+}
+
+float hit_energy_sum(const RVec<edm4eic::CalorimeterHitData>& hits) {
+  double sum = 0;
+  for (const auto& hit : hits) {
+    sum += hit.energy;
+  }
+  return static_cast<float>(sum);
+}
+
+} // namespace edm4eic::rdf
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+
+#include <TROOT.h>
+
+#include "podio/Frame.h"
+#include "podio/ROOTReader.h"
+
+#include "edm4eic/InclusiveKinematicsCollection.h"
+#include "edm4eic/event_index.h"
+#include "edm4eic/parallel_reader.h"
+
+namespace {
+
+// "column:min:max", with empty bounds left open
+edm4eic::event_index::range parse_range(const std::string& spec) {
+  const auto last = spec.rfind(':');
+  const auto first = last == std::string::npos || last == 0 ? std::string::npos : spec.rfind(':', last - 1);
+  if (first == std::string::npos) {
+    throw std::invalid_argument("range '" + spec + "' is not of the form column:min:max");
+  }
+  edm4eic::event_index::range range{spec.substr(0, first)};
+  const auto min = spec.substr(first + 1, last - first - 1);
+  const auto max = spec.substr(last + 1);
+  if (!min.empty()) range.min = std::stod(min);
+  if (!max.empty()) range.max = std::stod(max);
+  return range;
+}
+
+struct KinematicsColumns {
+  std::string collection;
+  std::span<float> x, Q2, y, W;
+};
+
+struct CountColumn {
+  std::string collection;
+  std::span<uint32_t> size;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  // setup CLI options
+  CLI::App app{"Sidecar event index for selecting events without reading frames"};
+  app.require_subcommand(1);
+
+  // build an index for a data file
+  auto* build = app.add_subcommand("build", "Build the index of a file");
+
+  std::string file_in{""};
+  build->add_option("input", file_in, "Input file")->required();
+
+  std::string file_idx{""};
+  build->add_option("--output,-o", file_idx, "Index file (default: input file with .idx appended)");
+
+  std::vector<std::string> kinematics{
+    "InclusiveKinematicsElectron",
+    "InclusiveKinematicsJB",
+    "InclusiveKinematicsDA",
+    "InclusiveKinematicsSigma",
+    "InclusiveKinematicsESigma"
+  };
+  build->add_option("--kinematics,-k", kinematics, "InclusiveKinematics collections to index x, Q2, y and W of");
+
+  std::vector<std::string> counts{
+    "ReconstructedParticles",
+    "ReconstructedChargedParticles",
+    "CentralCKFTracks",
+    "EcalBarrelClusters",
+    "EcalEndcapNClusters",
+    "EcalEndcapPClusters"
+  };
+  build->add_option("--count,-c", counts, "Collections to index the size of");
+
+  unsigned int numberOfThreads{1};
+  build->add_option("--threads,-j", numberOfThreads, "Number of reader threads");
+
+  // select entries from an index
+  auto* select = app.add_subcommand("select", "Print the entries passing all ranges");
+
+  std::string file_sel{""};
+  select->add_option("index", file_sel, "Index file")->required();
+
+  std::vector<std::string> ranges;
+  select->add_option("--range,-r", ranges, "Range column:min:max, e.g. InclusiveKinematicsElectron.Q2:100:")->required();
+
+  CLI11_PARSE(app, argc, argv);
+
+  if (*select) {
+    std::vector<edm4eic::event_index::range> predicates;
+    for (const auto& spec : ranges) {
+      predicates.push_back(parse_range(spec));
+    }
+    const edm4eic::event_index index(file_sel);
+    for (const auto entry : index.select(predicates)) {
+      std::cout << entry << "\n";
+    }
+    return 0;
+  }
+
+  if (file_idx.empty()) file_idx = file_in + ".idx";
+
+  // separate readers are used concurrently
+  ROOT::EnableThreadSafety();
+
+  edm4eic::parallel_reader<podio::ROOTReader> reader({file_in}, numberOfThreads);
+  edm4eic::event_index_builder builder(reader.entries());
+
+  std::vector<KinematicsColumns> kinematics_columns;
+  for (const auto& name : kinematics) {
+    kinematics_columns.push_back({name,
+        builder.add_float(name + ".x"),
+        builder.add_float(name + ".Q2"),
+        builder.add_float(name + ".y"),
+        builder.add_float(name + ".W")});
+  }
+  std::vector<CountColumn> count_columns;
+  for (const auto& name : counts) {
+    count_columns.push_back({name, builder.add_count(name + ".size")});
+  }
+
+  // every entry is filled by exactly one thread
+  reader.run([&](const podio::Frame& frame, std::size_t entry) {
+    const auto available = frame.getAvailableCollections();
+    auto is_available = [&available](const std::string& name) {
+      return std::find(available.begin(), available.end(), name) != available.end();
+    };
+    for (auto& column : kinematics_columns) {
+      if (!is_available(column.collection)) continue;
+      const auto& collection = frame.get<edm4eic::InclusiveKinematicsCollection>(column.collection);
+      if (collection.empty()) continue;
+      const auto kin = collection[0];
+      column.x[entry] = kin.getX();
+      column.Q2[entry] = kin.getQ2();
+      column.y[entry] = kin.getY();
+      column.W[entry] = kin.getW();
+    }
+    for (auto& column : count_columns) {
+      if (!is_available(column.collection)) continue;
+      column.size[entry] = frame.get(column.collection)->size();
+    }
+  });
+
+  builder.write(file_idx);
+  std::cout << "Indexed " << builder.entries() << " entries of " << file_in << " in " << file_idx << std::endl;
+
+  return 0;
+}
@@ -1,18 +1,121 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 // Copyright (C) 2022 Wouter Deconinck
 
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include <CLI/CLI.hpp>
 
-#include "podio/EventStore.h"
+#include <TROOT.h>
+
+#include "podio/Frame.h"
 #include "podio/ROOTReader.h"
 #include "podio/ROOTWriter.h"
 
-#include "edm4hep/SimCalorimeterHitCollection.h"
-#include "edm4hep/SimTrackerHitCollection.h"
+#include "edm4eic/background_pool.h"
+#include "edm4eic/bounded_queue.h"
+#include "edm4eic/bunch_timeline.h"
+#include "edm4eic/frame_splice.h"
+#include "edm4eic/quantization.h"
+
+namespace {
+
+// event to be spliced into the output at a time offset [ns], possibly
+// shared with other outputs through a background pool
+struct TimedEvent {
+  std::shared_ptr<const edm4eic::frame_buffers> buffers;
+  double time{0};
+};
+
+// background events to be overlaid on one signal event or time frame
+using BackgroundEvents = std::vector<TimedEvent>;
+
+// signal event with its position in the input file, or an empty time frame
+// with the signal events that arrive in it
+struct SignalEvent {
+  unsigned index;
+  edm4eic::frame_buffers buffers;
+  BackgroundEvents overlays;
+};
+
+// quantization of a merged collection
+using QuantizedCollections = std::vector<std::tuple<std::string, edm4eic::quantization>>;
+
+// merged event
+struct MergedEvent {
+  unsigned index;
+  podio::Frame frame;
+};
+
+// first exception thrown in any of the pipeline threads
+class ErrorState {
+public:
+  void set(std::exception_ptr e) {
+    std::lock_guard lock{m_mutex};
+    if (!m_error) {
+      m_error = e;
+    }
+  }
+  void rethrow() const {
+    std::lock_guard lock{m_mutex};
+    if (m_error) {
+      std::rethrow_exception(m_error);
+    }
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  std::exception_ptr m_error;
+};
+
+// splice background collections onto the signal collections, without
+// unpacking either into objects
+podio::Frame merge(edm4eic::frame_buffers buffers_sig, const std::vector<BackgroundEvents>& buffers_bkg,
+                   double tdc_period, const QuantizedCollections& quantized, bool debug) {
+  std::size_t dropped = edm4eic::restrict_relations(buffers_sig);
+  for (const auto& events_bkg : buffers_bkg) {
+    for (const auto& event_bkg : events_bkg) {
+      dropped += edm4eic::splice(buffers_sig, *event_bkg.buffers, {event_bkg.time, tdc_period});
+    }
+  }
+
+  if (debug) {
+    std::ostringstream os;
+    for (const auto& name : buffers_sig.names()) {
+      const auto* buffers = buffers_sig.buffers(name);
+      os << " out " << name << ": " << edm4eic::find_splice_ops(buffers->type)->size(*buffers) << "\n";
+    }
+    os << " relations to collections not merged: " << dropped << "\n";
+    std::cout << os.str() << std::flush;
+  }
+
+  for (const auto& [name, quantization] : quantized) {
+    edm4eic::quantize(buffers_sig, name, quantization);
+  }
+
+  // unpack here rather than in the writer thread
+  const auto names = buffers_sig.names();
+  auto frame_out = podio::Frame(std::make_unique<edm4eic::frame_buffers>(std::move(buffers_sig)));
+  for (const auto& name : names) {
+    frame_out.get(name);
+  }
+  return frame_out;
+}
+
+} // namespace
 
 int main(int argc, char **argv) {
   // setup CLI options
@@ -28,15 +131,33 @@ int main(int argc, char **argv) {
 
   // signal input file
   std::string file_sig{""};
-  app.add_option("--signal,-s", file_sig, "Signal file");
+  app.add_option("--signal,-s", file_sig, "Signal file")->required();
 
   // background input files
-  std::vector<std::tuple<std::string, unsigned int>> files_bkg{};
-  app.add_option("--background,-b", files_bkg, "Background files");
+  std::vector<std::tuple<std::string, double>> files_bkg{};
+  app.add_option("--background,-b", files_bkg, "Background file and count: the number of events per signal event (their mean with poisson sampling), or with --time-frame the rate of the background events in Hz");
+
+  // background sampling
+  std::string sampling{"sequential"};
+  app.add_option("--sampling", sampling, "Background sampling")
+     ->check(CLI::IsMember({"sequential", "random", "poisson"}));
+
+  // background reuse policy
+  std::string reuse{"replace"};
+  app.add_option("--reuse", reuse, "Background reuse for random sampling")
+     ->check(CLI::IsMember({"replace", "unique", "deck"}));
+
+  // random seed
+  uint64_t seed{1};
+  app.add_option("--seed", seed, "Random seed for background sampling");
+
+  // background pool size
+  double poolSize{0};
+  app.add_option("--pool-size", poolSize, "Memory for preloading the first background events per file in MB, the others are read on demand (0 to read all on demand)");
 
   // output file
   std::string file_out{""};
-  app.add_option("--output,-o", file_out, "Output file");
+  app.add_option("--output,-o", file_out, "Output file")->required();
 
   // collection include regex
   std::vector<std::string> include_regex{{".*"}};
@@ -46,125 +167,283 @@ int main(int argc, char **argv) {
   std::vector<std::string> exclude_regex{};
   app.add_option("--exclude,-e", exclude_regex, "Collection exclusion regex");
 
-  // signal input file
+  // lossy quantization
+  std::vector<std::tuple<std::string, std::string>> quantize_specs{};
+  app.add_option("--quantize", quantize_specs, "Collection regex and quantization, e.g. 'SimCalorimeterHits.*' 'position=linear:16:-4096:4096,energy=log:12:1e-6:1e3'");
+
+  // number of events
   unsigned int numberOfEvents{0};
-  app.add_option("--numberOfEvents,-n", numberOfEvents, "Number of events");
+  app.add_option("--numberOfEvents,-n", numberOfEvents, "Number of events (0 for all)");
+
+  // time frame length
+  double timeFrame{0};
+  app.add_option("--time-frame", timeFrame, "Build time frames of this length in ns instead of overlaying events");
+
+  // signal rate
+  double signalRate{0};
+  app.add_option("--signal-rate", signalRate, "Signal rate in Hz for time frames");
+
+  // bunch spacing
+  double bunchSpacing{10};
+  app.add_option("--bunch-spacing", bunchSpacing, "Time between bunch crossings in ns for time frames (0 for continuous)");
+
+  // TDC period for integer time stamps
+  double tdcPeriod{0};
+  app.add_option("--tdc-period", tdcPeriod, "TDC period in ns to shift integer time stamps (0 to leave them)");
+
+  // number of merge threads
+  unsigned int numberOfThreads{std::max(1u, std::thread::hardware_concurrency())};
+  app.add_option("--threads,-j", numberOfThreads, "Number of merge threads");
+
+  // depth of the queues between reader, merge and writer threads
+  unsigned int queueSize{0};
+  app.add_option("--queue-size,-q", queueSize, "Events buffered between pipeline stages (0 for twice the number of threads)");
 
   CLI11_PARSE(app, argc, argv);
 
   if (debug) verbose = true;
+  numberOfThreads = std::max(1u, numberOfThreads);
+  if (queueSize == 0) queueSize = 2 * numberOfThreads;
+  const auto background_sampling = edm4eic::background_sampling_from_string(sampling);
+  const auto background_reuse = edm4eic::background_reuse_from_string(reuse);
+  if (timeFrame > 0 && signalRate <= 0) {
+    std::cerr << "Time frames require a positive --signal-rate" << std::endl;
+    return 1;
+  }
+
+  // separate readers are used concurrently
+  ROOT::EnableThreadSafety();
 
   // input reader
   auto reader_sig = podio::ROOTReader();
-  auto store_sig = podio::EventStore();
   reader_sig.openFile(file_sig);
-  store_sig.setReader(&reader_sig);
+  unsigned n = reader_sig.getEntries("events");
+  if (numberOfEvents > 0) n = std::min(numberOfEvents, n);
+  if (n == 0) {
+    std::cout << "No events to merge" << std::endl;
+    return 0;
+  }
 
   // background readers
-  std::vector<std::tuple<podio::ROOTReader*, podio::EventStore*, unsigned int>> readers_stores_counts_bkg;
+  std::vector<std::tuple<std::unique_ptr<podio::ROOTReader>, double, unsigned int>> readers_counts_entries_bkg;
   for (const auto& [file_bkg, count_bkg]: files_bkg) {
-    readers_stores_counts_bkg.emplace_back(new podio::ROOTReader(), new podio::EventStore(), count_bkg);
-    std::get<0>(readers_stores_counts_bkg.back())->openFile(file_bkg);
-    std::get<1>(readers_stores_counts_bkg.back())->setReader(std::get<0>(readers_stores_counts_bkg.back()));
+    auto& [reader_bkg, count, entries] = readers_counts_entries_bkg.emplace_back(std::make_unique<podio::ROOTReader>(), count_bkg, 0);
+    reader_bkg->openFile(file_bkg);
+    entries = reader_bkg->getEntries("events");
+    if (entries == 0) {
+      std::cerr << "Background file " << file_bkg << " has no events" << std::endl;
+      return 1;
+    }
   }
 
-  // output writer
-  auto store_out = podio::EventStore();
-  auto writer_out = podio::ROOTWriter(file_out, &store_out);
+  // the first signal event determines the collections to merge
+  const auto frame_first = podio::Frame(reader_sig.readEntry("events", 0));
+
+  // compile regexes once
+  std::vector<std::regex> include_re, exclude_re;
+  for (const auto& re: include_regex) include_re.emplace_back(re);
+  for (const auto& re: exclude_regex) exclude_re.emplace_back(re);
 
-  // hit collections
-  auto coll_id_table_sig = store_sig.getCollectionIDTable();
-  std::vector<std::pair<size_t, std::string>> calorimeter_collection_names;
-  std::vector<std::pair<size_t, std::string>> tracker_collection_names;
-  for (const auto& name: coll_id_table_sig->names()) {
+  // hit collections, and the collections they relate to
+  std::vector<std::string> collection_names;
+  for (const auto& name: frame_first.getAvailableCollections()) {
     // check for inclusion
-    for (const auto& include_re: include_regex) {
-      if (std::regex_match(name, std::regex(include_re))) {
-        // check for exclusion
-        bool exclude = false;
-        for (const auto& exclude_re: exclude_regex) {
-          exclude = exclude || std::regex_match(name, std::regex(exclude_re));
-        }
-        // check for type by getting FIXME does not work
-        auto& hits_sig = store_sig.get<edm4hep::SimTrackerHitCollection>(name);
-        if (! store_sig.isValid()) {
-          std::cout << "Collection " << name << " invalid as tracker collection" << std::endl;
-          exclude = false;
-        }
-        //
-        if (exclude == false) {
-          std::cout << "Collection " << name << " included" << std::endl;
-          tracker_collection_names.push_back(std::make_pair(tracker_collection_names.size(), name));
-        }
-      }
+    auto matches = [&name](const auto& re) { return std::regex_match(name, re); };
+    if (std::none_of(include_re.begin(), include_re.end(), matches)) continue;
+    // check for exclusion
+    if (std::any_of(exclude_re.begin(), exclude_re.end(), matches)) continue;
+    // check for type
+    const auto* coll = frame_first.get(name);
+    if (coll == nullptr || coll->isSubsetCollection() || edm4eic::find_splice_ops(coll->getTypeName()) == nullptr) {
+      if (verbose) std::cout << "Collection " << name << " not supported for merging" << std::endl;
+      continue;
     }
+    std::cout << "Collection " << name << " included" << std::endl;
+    collection_names.push_back(name);
   }
 
-  // create output calorimeter collections
-  std::vector<edm4hep::SimCalorimeterHitCollection*> calorimeter_collections_out;
-  for (const auto& [i, calorimeter_collection_name]: calorimeter_collection_names) {
-    calorimeter_collections_out.push_back(&(store_out.create<edm4hep::SimCalorimeterHitCollection>(calorimeter_collection_name)));
-    writer_out.registerForWrite(calorimeter_collection_name);
+  // quantized collections, with the first matching quantization
+  QuantizedCollections quantized;
+  for (const auto& [re, spec]: quantize_specs) {
+    const std::regex quantize_re{re};
+    const auto quantization = edm4eic::quantization::from_string(spec);
+    for (const auto& name: collection_names) {
+      if (!std::regex_match(name, quantize_re)) continue;
+      if (std::any_of(quantized.begin(), quantized.end(), [&name](const auto& q) { return std::get<0>(q) == name; })) continue;
+      if (edm4eic::find_quantize_ops(frame_first.get(name)->getTypeName()) == nullptr) {
+        std::cerr << "Collection " << name << " not supported for quantization" << std::endl;
+        continue;
+      }
+      std::cout << "Collection " << name << " quantized as " << quantization.to_string() << std::endl;
+      quantized.emplace_back(name, quantization);
+    }
   }
 
-  // create output tracker collections
-  std::vector<edm4hep::SimTrackerHitCollection*> tracker_collections_out;
-  for (const auto& [i, tracker_collection_name]: tracker_collection_names) {
-    tracker_collections_out.push_back(&(store_out.create<edm4hep::SimTrackerHitCollection>(tracker_collection_name)));
-    writer_out.registerForWrite(tracker_collection_name);
+  // pipeline queues
+  edm4eic::bounded_queue<SignalEvent> queue_sig{queueSize};
+  std::vector<std::unique_ptr<edm4eic::bounded_queue<BackgroundEvents>>> queues_bkg;
+  for (std::size_t b = 0; b < readers_counts_entries_bkg.size(); ++b) {
+    queues_bkg.push_back(std::make_unique<edm4eic::bounded_queue<BackgroundEvents>>(queueSize));
   }
+  edm4eic::bounded_queue<MergedEvent> queue_out{queueSize};
 
-  // loop over events
-  unsigned n = std::min(numberOfEvents, reader_sig.getEntries());
-  for (unsigned i = 0; i < n; ++i) {
-    if (verbose) std::cout << "reading signal event " << i << "/" << n << std::endl;
-
-    // loop over signal collections
-    for (const auto& [i, tracker_collection_name]: tracker_collection_names) {
-      // clone signal hits
-      auto& hits_sig = store_sig.get<edm4hep::SimTrackerHitCollection>(tracker_collection_name);
-      if (debug) std::cout << " sig " << tracker_collection_name << ": " << hits_sig.size() << std::endl;
-      for (const auto& hit_sig: hits_sig) {
-        tracker_collections_out[i]->push_back(hit_sig.clone());
+  ErrorState error;
+  auto close_all = [&]() {
+    queue_sig.close();
+    for (auto& queue_bkg: queues_bkg) queue_bkg->close();
+    queue_out.close();
+  };
+  auto guarded = [&](auto&& body) {
+    return [&, body]() {
+      try {
+        body();
+      } catch (...) {
+        error.set(std::current_exception());
+        close_all();
       }
-    }
+    };
+  };
 
-    // loop over background collections
-    for (const auto& [reader_bkg, store_bkg, count_bkg]: readers_stores_counts_bkg) {
-      // repeat requested times
-      for (auto count = 0; count != count_bkg; ++count) {
-        // clone background hits (reader and store is pointer)
-        for (const auto& [i, tracker_collection_name]: tracker_collection_names) {
-          auto& hits_bkg = store_bkg->get<edm4hep::SimTrackerHitCollection>(tracker_collection_name);
-          if (debug) std::cout << " bkg" << i << " " << tracker_collection_name << ": " << hits_bkg.size() << std::endl;
-          for (const auto& hit_bkg: hits_bkg) {
-            tracker_collections_out[i]->push_back(hit_bkg.clone());
-          }
+  std::vector<std::thread> threads;
+
+  // timelines are seeded independently from the background sampling
+  auto timeline_seed = [seed](std::size_t source) { return (seed ^ 0x9e3779b97f4a7c15ULL) + source; };
+
+  // signal reader thread
+  threads.emplace_back(guarded([&]() {
+    if (timeFrame > 0) {
+      // lay out the signal events on the timeline, and fill empty time
+      // frames with the signal events that arrive in them
+      const auto frame_template = edm4eic::frame_buffers(reader_sig.readEntry("events", 0), collection_names);
+      edm4eic::bunch_timeline timeline{signalRate, bunchSpacing, timeline_seed(0)};
+      unsigned entry = 0;
+      for (unsigned i = 0; entry < n; ++i) {
+        const double start = i * timeFrame;
+        SignalEvent frame{i, edm4eic::frame_buffers::empty_like(frame_template), {}};
+        frame.buffers.parameters().set("TimeFrameStart", start);
+        frame.buffers.parameters().set("TimeFrameLength", timeFrame);
+        for (const auto time: timeline.arrivals(start, start + timeFrame)) {
+          if (entry == n) break;
+          if (verbose) std::cout << "reading signal event " << entry << "/" << n << " at " << time << " ns" << std::endl;
+          frame.overlays.push_back({std::make_shared<const edm4eic::frame_buffers>(reader_sig.readEntry("events", entry++), collection_names), time - start});
         }
-        store_bkg->clear();
-        reader_bkg->endOfEvent();
+        if (!queue_sig.push(std::move(frame))) break;
+      }
+    } else {
+      for (unsigned i = 0; i < n; ++i) {
+        if (verbose) std::cout << "reading signal event " << i << "/" << n << std::endl;
+        if (!queue_sig.push(SignalEvent{i, edm4eic::frame_buffers(reader_sig.readEntry("events", i), collection_names), {}})) break;
       }
     }
+    queue_sig.close();
+  }));
 
-    for (const auto& [i, tracker_collection_name]: tracker_collection_names) {
-      if (debug) std::cout << " out " << tracker_collection_name << ": " << tracker_collections_out[i]->size() << std::endl;
-    }
+  // background reader threads, one per background file; with time frames
+  // they run until the merge threads have consumed all signal events
+  for (std::size_t b = 0; b < readers_counts_entries_bkg.size(); ++b) {
+    threads.emplace_back(guarded([&, b]() {
+      auto& [reader_bkg, count_bkg, entries_bkg] = readers_counts_entries_bkg[b];
 
-    // clear input stores
-    store_sig.clear();
-    reader_sig.endOfEvent();
+      // preload the first background events, and read the others on demand
+      std::optional<edm4eic::background_pool> pool;
+      if (poolSize > 0) {
+        pool.emplace(*reader_bkg, collection_names, static_cast<std::size_t>(poolSize * 1024 * 1024));
+        if (pool->size() < entries_bkg) {
+          std::cout << "background " << b << ": pooled only " << pool->size() << "/" << entries_bkg << " events in " << pool->bytes() / 1024 / 1024 << " MB, reading the others on demand" << std::endl;
+        } else if (verbose) {
+          std::cout << "background " << b << ": pooled " << pool->size() << "/" << entries_bkg << " events, " << pool->bytes() / 1024 / 1024 << " MB" << std::endl;
+        }
+      }
+
+      // entries are drawn from the whole file, whether pooled or not
+      edm4eic::background_sampler sampler{entries_bkg, count_bkg, background_sampling, background_reuse, seed + b};
+      edm4eic::bunch_timeline timeline{timeFrame > 0 ? count_bkg : 0, bunchSpacing, timeline_seed(b + 1)};
+      for (unsigned i = 0; timeFrame > 0 || i < n; ++i) {
+        // entries to overlay and their times within the time frame
+        std::vector<double> times;
+        std::vector<std::size_t> entries;
+        if (timeFrame > 0) {
+          const double start = i * timeFrame;
+          times = timeline.arrivals(start, start + timeFrame);
+          for (auto& time: times) time -= start;
+          entries = sampler.next(times.size());
+        } else {
+          entries = sampler.next();
+          times.assign(entries.size(), 0);
+        }
 
-    // write event
-    writer_out.writeEvent();
-    store_out.clearCollections();
+        BackgroundEvents frames;
+        for (std::size_t k = 0; k < entries.size(); ++k) {
+          if (pool && entries[k] < pool->size()) {
+            frames.push_back({(*pool)[entries[k]], times[k]});
+          } else {
+            frames.push_back({std::make_shared<const edm4eic::frame_buffers>(reader_bkg->readEntry("events", entries[k]), collection_names), times[k]});
+          }
+        }
+        if (!queues_bkg[b]->push(std::move(frames))) break;
+      }
+      queues_bkg[b]->close();
+    }));
   }
 
-  // close files
-  reader_sig.closeFile();
-  for (const auto& [reader_bkg, store_bkg, count_bkg]: readers_stores_counts_bkg) {
-    reader_bkg->closeFile();
+  // merge threads; the signal event and its background events are taken
+  // together so that the overlay does not depend on thread scheduling
+  std::mutex dispatch_mutex;
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < numberOfThreads; ++t) {
+    workers.emplace_back(guarded([&]() {
+      while (true) {
+        std::optional<SignalEvent> event_sig;
+        std::vector<BackgroundEvents> frames_bkg;
+        {
+          std::lock_guard lock{dispatch_mutex};
+          event_sig = queue_sig.pop();
+          if (!event_sig) break;
+          frames_bkg.push_back(std::move(event_sig->overlays));
+          for (auto& queue_bkg: queues_bkg) {
+            auto frames = queue_bkg->pop();
+            if (!frames) return;
+            frames_bkg.push_back(std::move(*frames));
+          }
+        }
+        auto frame_out = merge(std::move(event_sig->buffers), frames_bkg, tdcPeriod, quantized, debug);
+        if (!queue_out.push(MergedEvent{event_sig->index, std::move(frame_out)})) break;
+      }
+    }));
+  }
+
+  // writer thread, restoring the signal event order
+  std::thread writer_thread(guarded([&]() {
+    auto writer_out = podio::ROOTWriter(file_out);
+    std::map<unsigned, MergedEvent> pending;
+    unsigned next = 0;
+    while (auto merged = queue_out.pop()) {
+      pending.emplace(merged->index, std::move(*merged));
+      for (auto it = pending.find(next); it != pending.end(); it = pending.find(next)) {
+        if (verbose) std::cout << "writing event " << next << std::endl;
+        writer_out.writeFrame(it->second.frame, "events");
+        pending.erase(it);
+        ++next;
+      }
+    }
+    writer_out.finish();
+  }));
+
+  // wait for the workers, stop the readers, then let the writer drain
+  for (auto& worker: workers) worker.join();
+  queue_sig.close();
+  for (auto& queue_bkg: queues_bkg) queue_bkg->close();
+  for (auto& thread: threads) thread.join();
+  queue_out.close();
+  writer_thread.join();
+
+  // report the first failure of any thread
+  try {
+    error.rethrow();
+  } catch (const std::exception& e) {
+    std::cerr << "Merging failed: " << e.what() << std::endl;
+    return 1;
   }
-  writer_out.finish();
 
   return 0;
 }
@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+
+namespace {
+
+struct member_layout {
+  std::string_view name;
+  std::string_view type;
+  std::size_t offset;
+  std::size_t size;
+  std::size_t align;
+  bool range; // generated <relation>_begin/_end, always after the members
+};
+
+struct type_layout {
+  std::string_view name;
+  std::size_t size;
+  std::size_t align;
+  std::vector<member_layout> members;
+};
+
+} // namespace
+
+#define EDM4EIC_LAYOUT_MEMBER(T, m, type) member_layout{#m, type, offsetof(T, m), sizeof(T::m), alignof(decltype(T::m)), false}
+#define EDM4EIC_LAYOUT_RANGE(T, m) member_layout{#m, "unsigned int", offsetof(T, m), sizeof(T::m), alignof(decltype(T::m)), true}
+#define EDM4EIC_LAYOUT_TYPE(T, ...) type_layout{#T, sizeof(T), alignof(T), {__VA_ARGS__}}
+
+// generated from edm4eic.yaml, defines schema_layouts
+#include "edm4eic_layout_table.h"
+
+namespace {
+
+std::size_t align_up(const std::size_t offset, const std::size_t align) {
+  return (offset + align - 1) / align * align;
+}
+
+std::size_t payload(const type_layout& type) {
+  return std::accumulate(type.members.begin(), type.members.end(), std::size_t{0},
+                         [](std::size_t sum, const member_layout& m) { return sum + m.size; });
+}
+
+// Average number of cache lines touched by an object in a contiguous array
+double lines_per_object(const std::size_t size, const std::size_t line) {
+  const std::size_t period = std::lcm(size, line) / size;
+  std::size_t lines = 0;
+  for (std::size_t i = 0; i < period; ++i) {
+    lines += (i * size + size - 1) / line - i * size / line + 1;
+  }
+  return static_cast<double>(lines) / static_cast<double>(period);
+}
+
+// Members by decreasing alignment, keeping the generated ranges last
+std::vector<member_layout> reordered(const type_layout& type) {
+  auto members = type.members;
+  std::stable_sort(members.begin(), members.end(), [](const member_layout& a, const member_layout& b) {
+    if (a.range != b.range) return b.range;
+    return !a.range && a.align > b.align;
+  });
+  return members;
+}
+
+std::size_t size_of(const std::vector<member_layout>& members, const std::size_t align) {
+  std::size_t offset = 0;
+  for (const auto& m : members) {
+    offset = align_up(offset, m.align) + m.size;
+  }
+  return align_up(std::max<std::size_t>(offset, 1), align);
+}
+
+void print_padding(const type_layout& type) {
+  auto members = type.members;
+  std::sort(members.begin(), members.end(),
+            [](const member_layout& a, const member_layout& b) { return a.offset < b.offset; });
+  std::size_t end = 0;
+  for (const auto& m : members) {
+    if (m.offset > end) {
+      std::printf("    %zu bytes of padding before %s (%s, align %zu)\n", m.offset - end, m.name.data(),
+                  m.type.data(), m.align);
+    }
+    end = m.offset + m.size;
+  }
+  if (!members.empty() && type.size > end) {
+    std::printf("    %zu bytes of tail padding to align %zu\n", type.size - end, type.align);
+  }
+}
+
+void print_reordering(const type_layout& type) {
+  const auto members = reordered(type);
+  const std::size_t size = size_of(members, type.align);
+  if (size >= type.size) {
+    return;
+  }
+  std::printf("    reordered Members give %zu bytes:", size);
+  for (const auto& m : members) {
+    if (!m.range) {
+      std::printf(" %s", m.name.data());
+    }
+  }
+  std::printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  // setup CLI options
+  CLI::App app{"Memory layout of the generated edm4eic components and datatypes"};
+
+  std::string filter = ".*";
+  app.add_option("--type", filter, "Regular expression of the types to report");
+
+  std::size_t cache_line = 64;
+  app.add_option("--cache-line", cache_line, "Cache line size in bytes")->check(CLI::PositiveNumber);
+
+  std::vector<std::string> budget_specs;
+  app.add_option("--budget", budget_specs,
+                 "Size budget of a type, e.g. edm4eic::CalorimeterHitData=72; fails if the type is larger");
+
+  bool warn_only = false;
+  app.add_flag("--warn-only", warn_only, "Only warn about types over budget");
+
+  bool details = false;
+  app.add_flag("--details,-d", details, "Show the padding and suggested member order of every type");
+
+  CLI11_PARSE(app, argc, argv);
+
+  std::map<std::string, std::size_t> budgets;
+  for (const auto& spec : budget_specs) {
+    const auto eq = spec.find('=');
+    if (eq == std::string::npos) {
+      std::cerr << "budget '" << spec << "' is not of the form type=bytes" << std::endl;
+      return 1;
+    }
+    const auto name = spec.substr(0, eq);
+    if (std::none_of(schema_layouts.begin(), schema_layouts.end(),
+                     [&](const type_layout& type) { return type.name == name; })) {
+      std::cerr << "budget for unknown type " << name << std::endl;
+      return 1;
+    }
+    budgets[name] = std::stoul(spec.substr(eq + 1));
+  }
+
+  const std::regex re(filter);
+  std::printf("%-48s %6s %6s %8s %8s %7s %7s\n", "type", "size", "align", "payload", "padding", "lines",
+              "packed");
+  std::size_t over_budget = 0;
+  for (const auto& type : schema_layouts) {
+    const std::string name{type.name};
+    const auto budget = budgets.find(name);
+    if (!std::regex_match(name, re) && budget == budgets.end()) {
+      continue;
+    }
+
+    const std::size_t packed = size_of(reordered(type), type.align);
+    std::printf("%-48s %6zu %6zu %8zu %8zu %7.2f %7zu\n", name.c_str(), type.size, type.align, payload(type),
+                type.size - payload(type), lines_per_object(type.size, cache_line), packed);
+    if (details || packed < type.size) {
+      print_padding(type);
+      print_reordering(type);
+    }
+
+    if (budget != budgets.end() && type.size > budget->second) {
+      std::cerr << name << " grew from " << budget->second << " to " << type.size << " bytes" << std::endl;
+      ++over_budget;
+    } else if (budget != budgets.end() && type.size < budget->second) {
+      std::printf("    %s shrank from %zu to %zu bytes, the budget can be lowered\n", name.c_str(), budget->second,
+                  type.size);
+    }
+  }
+
+  return over_budget > 0 && !warn_only ? 1 : 0;
+}
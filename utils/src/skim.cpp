@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later
+// Copyright (C) 2026 agent
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+
+#include <TBranch.h>
+#include <TBranchElement.h>
+#include <TChain.h>
+#include <TFile.h>
+#include <TObjArray.h>
+#include <TTree.h>
+
+#include "podio/CollectionIDTable.h"
+#include "podio/ObjectID.h"
+#include "podio/utilities/RootHelpers.h"
+
+namespace {
+
+// podio ROOT file layout: one tree per frame category, and the collection
+// ID table and type info of every category in the metadata tree
+constexpr auto metadata_tree = "podio_metadata";
+std::string id_table_branch(const std::string& category) { return category + "___idTable"; }
+std::string type_info_branch(const std::string& category) { return category + "___CollectionTypeInfo"; }
+
+// Collection that owns a branch of a category tree: the data branch carries
+// the collection name, relation and VectorMember branches are "_<name>_<member>",
+// subset collections store "<name>_objIdx". The longest matching name wins,
+// since collection names may be prefixes of one another. Branches owned by
+// no collection, e.g. the frame parameters, are always copied.
+std::optional<std::string> branch_owner(const std::string& branch, const std::vector<std::string>& collections) {
+  std::optional<std::string> owner;
+  for (const auto& name : collections) {
+    const bool owns = branch == name
+        || (branch.size() > name.size() + 2 && branch.starts_with("_" + name + "_"))
+        || (branch.size() > name.size() + 1 && branch.starts_with(name + "_"));
+    if (owns && (!owner || name.size() > owner->size())) owner = name;
+  }
+  return owner;
+}
+
+// references into dropped collections, by branch and target collection
+using DroppedRelations = std::map<std::tuple<std::string, std::string>, std::size_t>;
+
+// count the ObjectIDs in the relation branches of the kept collections that
+// point into dropped collections; only these branches are read, through a
+// chain of its own, so that no branch address outlives this function
+DroppedRelations check_relations(const std::vector<std::string>& files, const std::string& category,
+                                 const std::vector<std::string>& relation_branches,
+                                 const podio::CollectionIDTable& table, const std::set<uint32_t>& kept_ids) {
+  DroppedRelations dropped;
+  if (relation_branches.empty()) return dropped;
+
+  TChain chain{category.c_str()};
+  for (const auto& file : files) chain.Add(file.c_str());
+  chain.SetBranchStatus("*", false);
+  // allocated by ROOT on the first read
+  std::vector<std::vector<podio::ObjectID>*> refs(relation_branches.size(), nullptr);
+  for (std::size_t k = 0; k < relation_branches.size(); ++k) {
+    chain.SetBranchStatus(relation_branches[k].c_str(), true);
+    chain.SetBranchAddress(relation_branches[k].c_str(), &refs[k]);
+  }
+
+  for (Long64_t entry = 0; chain.GetEntry(entry) > 0; ++entry) {
+    for (std::size_t k = 0; k < relation_branches.size(); ++k) {
+      if (refs[k] == nullptr) continue;
+      for (const auto& id : *refs[k]) {
+        if (id.index < 0 || kept_ids.contains(id.collectionID)) continue;
+        const auto target = table.name(id.collectionID);
+        ++dropped[{relation_branches[k], target ? std::string(*target) : std::to_string(id.collectionID)}];
+      }
+    }
+  }
+
+  chain.ResetBranchAddresses();
+  for (auto* ref : refs) delete ref;
+  return dropped;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  // setup CLI options
+  CLI::App app{"Copy selected collections of podio files without unpacking them"};
+
+  // verbose
+  bool verbose{false};
+  app.add_flag("--verbose,-v", verbose, "Enable verbose output");
+
+  // input files
+  std::vector<std::string> files_in;
+  app.add_option("input", files_in, "Input files")->required();
+
+  // output file
+  std::string file_out{""};
+  app.add_option("--output,-o", file_out, "Output file")->required();
+
+  // collection include regex
+  std::vector<std::string> include_regex{{".*"}};
+  app.add_option("--include,-i", include_regex, "Collection inclusion regex");
+
+  // collection exclude regex
+  std::vector<std::string> exclude_regex{};
+  app.add_option("--exclude,-e", exclude_regex, "Collection exclusion regex");
+
+  // skip reading the relation branches
+  bool noRelationCheck{false};
+  app.add_flag("--no-relation-check", noRelationCheck, "Do not report relations into dropped collections");
+
+  CLI11_PARSE(app, argc, argv);
+
+  // compile regexes once
+  std::vector<std::regex> include_re, exclude_re;
+  for (const auto& re: include_regex) include_re.emplace_back(re);
+  for (const auto& re: exclude_regex) exclude_re.emplace_back(re);
+  auto selected = [&](const std::string& name) {
+    auto matches = [&name](const auto& re) { return std::regex_match(name, re); };
+    return std::any_of(include_re.begin(), include_re.end(), matches)
+        && std::none_of(exclude_re.begin(), exclude_re.end(), matches);
+  };
+
+  // the metadata of the first file describes all files
+  std::unique_ptr<TFile> file_first{TFile::Open(files_in.front().c_str(), "READ")};
+  auto* metadata_in = file_first ? file_first->Get<TTree>(metadata_tree) : nullptr;
+  if (metadata_in == nullptr) {
+    std::cerr << files_in.front() << " is not a podio file" << std::endl;
+    return 1;
+  }
+
+  // categories, with their collection ID table and type info
+  struct Category {
+    std::string name;
+    podio::CollectionIDTable* table{nullptr};
+    std::vector<podio::root_utils::CollectionWriteInfo>* types{nullptr};
+  };
+  std::vector<Category> categories;
+  for (const auto* branch : *metadata_in->GetListOfBranches()) {
+    const std::string name = branch->GetName();
+    if (!name.ends_with("___idTable")) continue;
+    auto& category = categories.emplace_back();
+    category.name = name.substr(0, name.size() - std::string("___idTable").size());
+    metadata_in->SetBranchAddress(id_table_branch(category.name).c_str(), &category.table);
+    metadata_in->SetBranchAddress(type_info_branch(category.name).c_str(), &category.types);
+  }
+  metadata_in->GetEntry(0);
+
+  std::unique_ptr<TFile> output{TFile::Open(file_out.c_str(), "RECREATE")};
+  if (!output || output->IsZombie()) {
+    std::cerr << "Cannot create " << file_out << std::endl;
+    return 1;
+  }
+
+  std::size_t dropped_total = 0;
+  for (auto& category : categories) {
+    const auto& names = category.table->names();
+    std::set<uint32_t> kept_ids;
+    for (const auto& name : names) {
+      if (selected(name)) {
+        kept_ids.insert(*category.table->collectionID(name));
+        if (verbose) std::cout << category.name << ": collection " << name << " included" << std::endl;
+      }
+    }
+
+    TChain chain{category.name.c_str()};
+    for (const auto& file_in : files_in) chain.Add(file_in.c_str());
+    if (chain.LoadTree(0) < 0) continue;
+
+    // branches of dropped collections are disabled and not cloned
+    std::vector<std::string> relation_branches;
+    chain.SetBranchStatus("*", true);
+    for (auto* object : *chain.GetListOfBranches()) {
+      auto* branch = static_cast<TBranch*>(object);
+      const std::string branch_name = branch->GetName();
+      const auto owner = branch_owner(branch_name, names);
+      if (!owner) continue;
+      if (!selected(*owner)) {
+        chain.SetBranchStatus(branch_name.c_str(), false);
+        continue;
+      }
+      auto* element = dynamic_cast<TBranchElement*>(branch);
+      if (branch_name != *owner && element != nullptr
+          && std::string(element->GetClassName()) == "vector<podio::ObjectID>") {
+        relation_branches.push_back(branch_name);
+      }
+    }
+
+    // before cloning, the clone shares the branch addresses of the chain
+    DroppedRelations dropped;
+    if (!noRelationCheck) {
+      dropped = check_relations(files_in, category.name, relation_branches, *category.table, kept_ids);
+    }
+
+    // baskets are copied without decompression
+    output->cd();
+    auto* tree_out = chain.CloneTree(0);
+    tree_out->CopyEntries(&chain, -1, "fast");
+    std::cout << category.name << ": copied " << tree_out->GetEntries() << " entries with " << kept_ids.size()
+              << "/" << names.size() << " collections" << std::endl;
+
+    for (const auto& [key, count] : dropped) {
+      const auto& [branch, target] = key;
+      std::cout << category.name << ": " << count << " references in " << branch
+                << " point to dropped collection " << target << std::endl;
+      dropped_total += count;
+    }
+
+    // restrict the ID table and type info to the kept collections
+    std::vector<uint32_t> ids;
+    std::vector<std::string> kept_names;
+    for (const auto& name : names) {
+      const auto id = *category.table->collectionID(name);
+      if (!kept_ids.contains(id)) continue;
+      ids.push_back(id);
+      kept_names.push_back(name);
+    }
+    *category.table = podio::CollectionIDTable(std::move(ids), std::move(kept_names));
+    std::erase_if(*category.types, [&](const auto& info) { return !kept_ids.contains(info.collectionID); });
+  }
+
+  // the cloned metadata tree shares the (restricted) objects of the input
+  output->cd();
+  auto* metadata_out = metadata_in->CloneTree(0);
+  metadata_out->Fill();
+  output->Write();
+  output->Close();
+
+  if (dropped_total > 0) {
+    std::cout << dropped_total << " references point to dropped collections and cannot be resolved" << std::endl;
+  }
+
+  return 0;
+}